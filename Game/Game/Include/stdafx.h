@@ -22,6 +22,7 @@
 #include <string>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <list>
 #include <stack>
 #include <set>
@@ -31,6 +32,10 @@
 #include <memory>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
 #include <math.h>
 #include <algorithm>
 
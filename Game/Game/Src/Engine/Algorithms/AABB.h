@@ -25,6 +25,35 @@ public:
 				(minCoords.z <= other.maxCoords.z && maxCoords.z >= other.minCoords.z));
 	}
 
+	// Intersection between the AABB & a sphere
+	bool IntersectsSphere(const Vector3& center, float radius) const
+	{
+		// Distance from the center to the closest point of the AABB
+		float dx = std::max(minCoords.x - center.x, std::max(0.0f, center.x - maxCoords.x));
+		float dy = std::max(minCoords.y - center.y, std::max(0.0f, center.y - maxCoords.y));
+		float dz = std::max(minCoords.z - center.z, std::max(0.0f, center.z - maxCoords.z));
+		return (dx * dx + dy * dy + dz * dz) <= radius * radius;
+	}
+
+	// Is the other AABB completely inside this one?
+	bool Contains(const AABB& other) const
+	{
+		return ((minCoords.x <= other.minCoords.x && maxCoords.x >= other.maxCoords.x) &&
+				(minCoords.y <= other.minCoords.y && maxCoords.y >= other.maxCoords.y) &&
+				(minCoords.z <= other.minCoords.z && maxCoords.z >= other.maxCoords.z));
+	}
+
+	// Grow this AABB to cover the other one too
+	void Merge(const AABB& other)
+	{
+		minCoords.x = std::min(minCoords.x, other.minCoords.x);
+		minCoords.y = std::min(minCoords.y, other.minCoords.y);
+		minCoords.z = std::min(minCoords.z, other.minCoords.z);
+		maxCoords.x = std::max(maxCoords.x, other.maxCoords.x);
+		maxCoords.y = std::max(maxCoords.y, other.maxCoords.y);
+		maxCoords.z = std::max(maxCoords.z, other.maxCoords.z);
+	}
+
 	// Get normal to the intersection plane between two AABBs
 	Vector3 GetIntersectionNormal(const AABB& other) const
 	{
@@ -44,6 +73,43 @@ public:
 		return Vector3(0.0f, 0.0f, 0.0f);
 	}
 
+	/**
+	 * @brief Get the penetration between two AABBs.
+	 *
+	 * @param other The other AABB
+	 * @param normal Set to the direction in which this AABB must move to get out of the other one
+	 * @param depth Set to the distance this AABB must move (along normal) to get out of the other one
+	 * @return Do the AABBs intersect (touching counts as intersecting)?
+	 */
+	bool GetPenetration(const AABB& other, Vector3& normal, float& depth) const
+	{
+		float intersect[3] = {
+			std::min(maxCoords.x, other.maxCoords.x) - std::max(minCoords.x, other.minCoords.x),
+			std::min(maxCoords.y, other.maxCoords.y) - std::max(minCoords.y, other.minCoords.y),
+			std::min(maxCoords.z, other.maxCoords.z) - std::max(minCoords.z, other.minCoords.z)
+		};
+		if (intersect[0] < 0.0f || intersect[1] < 0.0f || intersect[2] < 0.0f)
+			return false;
+
+		// Separate along the axis with minimum intersection
+		int axis = (intersect[0] < intersect[1]) ? ((intersect[0] < intersect[2]) ? 0 : 2) : ((intersect[1] < intersect[2]) ? 1 : 2);
+		depth = intersect[axis];
+
+		// Push away from the other AABB's center
+		float center = minCoords[axis] + maxCoords[axis];
+		float otherCenter = other.minCoords[axis] + other.maxCoords[axis];
+		float sign = (center < otherCenter) ? -1.0f : 1.0f;
+		normal = Vector3(0.0f, 0.0f, 0.0f);
+		if (axis == 0)
+			normal.x = sign;
+		else if (axis == 1)
+			normal.y = sign;
+		else
+			normal.z = sign;
+
+		return true;
+	}
+
 	std::string ToString() const
 	{
 		return "AABB( min=" + minCoords.ToString() + ", max=" + maxCoords.ToString() + " )";
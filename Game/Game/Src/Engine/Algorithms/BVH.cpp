@@ -9,27 +9,31 @@
 
 // --------------------------- Private member functions ---------------------------
 
-BVHNode* BVH::BuildTreeInternal(std::vector<BoxCollider*>& colliders)
+BVHNode* BVH::BuildTreeInternal(std::vector<BVHBuildItem>& items)
 {
-	if (colliders.size() == 0)
+	if (items.size() == 0)
 	{
 		return nullptr;
 	}
 
 	// Create a new node that contains all colliders
-	AABB nodeBoundingBox = GetEnclosingBoundingBox(colliders);
+	AABB nodeBoundingBox = GetEnclosingBoundingBox(items);
 	BVHNode* node = new BVHNode(nodeBoundingBox);
 
 	// If number of colliders is less, make it leaf
-	if (colliders.size() <= 4)
+	if (items.size() <= 4)
 	{
-		node->colliders = colliders;
+		for (const BVHBuildItem& item : items)
+		{
+			node->colliders.push_back(item.collider);
+			node->colliderHandles.push_back(item.handle);
+		}
 	}
 	else
 	{
 		// Split colliders into two groups along the longest axis
-		std::vector<BoxCollider*> leftColliders, rightColliders;
-		SplitColliders(colliders, nodeBoundingBox, leftColliders, rightColliders);
+		std::vector<BVHBuildItem> leftColliders, rightColliders;
+		SplitColliders(items, nodeBoundingBox, leftColliders, rightColliders);
 
 		// Recursively build left and right child nodes
 		node->left = BuildTreeInternal(leftColliders);
@@ -44,7 +48,7 @@ BVHNode* BVH::BuildTreeInternal(std::vector<BoxCollider*>& colliders)
 	return node;
 }
 
-BoxCollider* BVH::CheckCollisions(BVHNode* node, BoxCollider* collider, Vector3& normal, ColliderTag colliderTag) const
+BoxCollider* BVH::CheckCollisions(BVHNode* node, BoxCollider* collider, Vector3& normal, ColliderTag colliderTag, const DenseRegistry<Collider*>* registry) const
 {
 	// If the node does not intersect with box collider then no need of checking its child nodes
 	if (node == nullptr || !node->boundingBox.Intersects(collider->boundingBox))
@@ -53,9 +57,14 @@ BoxCollider* BVH::CheckCollisions(BVHNode* node, BoxCollider* collider, Vector3&
 	// For the leaf node, we check individual collisions with all the colliders
 	if (node->IsLeaf())
 	{
-		for (BoxCollider* leafC : node->colliders)
+		for (size_t i = 0; i < node->colliders.size(); i++)
 		{
-			if ((collider->GetUid() != leafC->GetUid()) &&
+			if (registry != nullptr && !registry->IsValid(node->colliderHandles[i]))
+				continue;
+
+			BoxCollider* leafC = node->colliders[i];
+			// Triggers are not solid
+			if (!leafC->IsTrigger() && (collider->GetUid() != leafC->GetUid()) &&
 				(collider->boundingBox.Intersects(leafC->boundingBox) &&
 				(colliderTag == GENERIC || leafC->GetColliderTag() == colliderTag)))
 			{
@@ -68,16 +77,56 @@ BoxCollider* BVH::CheckCollisions(BVHNode* node, BoxCollider* collider, Vector3&
 	}
 
 	// Collision happened with this BVH node so check child nodes
-	BoxCollider* leftBoxCol = CheckCollisions(node->left, collider, normal, colliderTag);
+	BoxCollider* leftBoxCol = CheckCollisions(node->left, collider, normal, colliderTag, registry);
 	if (leftBoxCol != nullptr)
 		return leftBoxCol;
-	BoxCollider* rightBoxCol = CheckCollisions(node->right, collider, normal, colliderTag);
+	BoxCollider* rightBoxCol = CheckCollisions(node->right, collider, normal, colliderTag, registry);
 	if (rightBoxCol != nullptr)
 		return rightBoxCol;
 
 	return nullptr;
 }
 
+void BVH::QueryOverlaps(BVHNode* node, const AABB& aabb, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const
+{
+	if (node == nullptr || !node->boundingBox.Intersects(aabb))
+		return;
+
+	if (node->IsLeaf())
+	{
+		for (BoxCollider* leafC : node->colliders)
+		{
+			if (leafC->IsTrigger() == triggers && (tagMask & ColliderTagBit(leafC->GetColliderTag())) &&
+				leafC->boundingBox.Intersects(aabb))
+				result.push_back(leafC);
+		}
+		return;
+	}
+
+	QueryOverlaps(node->left, aabb, result, triggers, tagMask);
+	QueryOverlaps(node->right, aabb, result, triggers, tagMask);
+}
+
+void BVH::QuerySphereOverlaps(BVHNode* node, const Vector3& center, float radius, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const
+{
+	if (node == nullptr || !node->boundingBox.IntersectsSphere(center, radius))
+		return;
+
+	if (node->IsLeaf())
+	{
+		for (BoxCollider* leafC : node->colliders)
+		{
+			if (leafC->IsTrigger() == triggers && (tagMask & ColliderTagBit(leafC->GetColliderTag())) &&
+				leafC->boundingBox.IntersectsSphere(center, radius))
+				result.push_back(leafC);
+		}
+		return;
+	}
+
+	QuerySphereOverlaps(node->left, center, radius, result, triggers, tagMask);
+	QuerySphereOverlaps(node->right, center, radius, result, triggers, tagMask);
+}
+
 //bool BVH::AddCollider(BVHNode* node, BoxCollider* collider)
 //{
 //	if (node == nullptr || !node->boundingBox.Intersects(collider->boundingBox))
@@ -112,7 +161,17 @@ AABB BVH::GetEnclosingBoundingBox(const std::vector<BoxCollider*>& colliders) co
 	return AABB(minC, maxC);
 }
 
-void BVH::SplitColliders(std::vector<BoxCollider*>& colliders, AABB& nodeBB, std::vector<BoxCollider*>& left, std::vector<BoxCollider*>& right)
+AABB BVH::GetEnclosingBoundingBox(const std::vector<BVHBuildItem>& items) const
+{
+	Vector3 minC(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+	Vector3 maxC(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+	AABB enclosing(minC, maxC);
+	for (const BVHBuildItem& item : items)
+		enclosing.Merge(item.boundingBox);
+	return enclosing;
+}
+
+void BVH::SplitColliders(std::vector<BVHBuildItem>& items, AABB& nodeBB, std::vector<BVHBuildItem>& left, std::vector<BVHBuildItem>& right)
 {
 	// Find the longest axis
 	Vector3 extents = nodeBB.maxCoords - nodeBB.minCoords;
@@ -120,14 +179,14 @@ void BVH::SplitColliders(std::vector<BoxCollider*>& colliders, AABB& nodeBB, std
 	int longestAxis = (extents.x > extents.y) ? ((extents.x > extents.z) ? 0 : 2) : ((extents.y > extents.z) ? 1 : 2);
 
 	// Sort colliders based on the min values on the longest axis
-	std::sort(colliders.begin(), colliders.end(), [longestAxis](BoxCollider* a, BoxCollider* b) {
-		return a->boundingBox.minCoords[longestAxis] < b->boundingBox.minCoords[longestAxis];
+	std::sort(items.begin(), items.end(), [longestAxis](const BVHBuildItem& a, const BVHBuildItem& b) {
+		return a.boundingBox.minCoords[longestAxis] < b.boundingBox.minCoords[longestAxis];
 		});
 
 	// Split colliders into 2 halfs
-	size_t halfSize = colliders.size() / 2;
-	left.assign(colliders.begin(), colliders.begin() + halfSize);
-	right.assign(colliders.begin() + halfSize, colliders.end());
+	size_t halfSize = items.size() / 2;
+	left.assign(items.begin(), items.begin() + halfSize);
+	right.assign(items.begin() + halfSize, items.end());
 }
 
 void BVH::RebuildTree(BVHNode* node)
@@ -176,6 +235,43 @@ void BVH::RebuildTree(BVHNode* node)
 	node->boundingBox.maxCoords.z = std::max(first.maxCoords.z, second.maxCoords.z);
 }
 
+BVHNode* BVH::CopyTree(const BVHNode* node, BVHNode* parent)
+{
+	if (node == nullptr)
+		return nullptr;
+
+	BVHNode* copy = new BVHNode(node->boundingBox);
+	copy->colliders = node->colliders;
+	copy->colliderHandles = node->colliderHandles;
+	copy->parent = parent;
+	copy->left = CopyTree(node->left, copy);
+	copy->right = CopyTree(node->right, copy);
+	return copy;
+}
+
+size_t BVH::DropRemovedColliders(BVHNode* node, const DenseRegistry<Collider*>& registry)
+{
+	if (node == nullptr)
+		return 0;
+
+	if (!node->IsLeaf())
+		return DropRemovedColliders(node->left, registry) + DropRemovedColliders(node->right, registry);
+
+	size_t kept = 0;
+	for (size_t i = 0; i < node->colliders.size(); i++)
+	{
+		if (!registry.IsValid(node->colliderHandles[i]))
+			continue;
+		node->colliders[kept] = node->colliders[i];
+		node->colliderHandles[kept] = node->colliderHandles[i];
+		++kept;
+	}
+	size_t dropped = node->colliders.size() - kept;
+	node->colliders.resize(kept);
+	node->colliderHandles.resize(kept);
+	return dropped;
+}
+
 void BVH::Destroy(BVHNode* node)
 {
 	if (node == nullptr)
@@ -198,39 +294,92 @@ void BVH::Destroy(BVHNode* node)
 	}
 }
 
+size_t BVH::GetMemoryUsage(const BVHNode* node) const
+{
+	if (node == nullptr)
+		return 0;
+
+	return sizeof(BVHNode) + node->colliders.capacity() * sizeof(BoxCollider*) +
+		   GetMemoryUsage(node->left) + GetMemoryUsage(node->right);
+}
+
 // --------------------------- Public member functions ---------------------------
 
 void BVH::BuildTree(std::vector<BoxCollider*>& colliders)
 {
-	root = BuildTreeInternal(colliders);
+	std::vector<BVHBuildItem> items(colliders.size());
+	for (size_t i = 0; i < colliders.size(); i++)
+	{
+		items[i].boundingBox = colliders[i]->boundingBox;
+		items[i].collider = colliders[i];
+		items[i].handle = colliders[i]->collisionHandle;
+	}
+	BuildTree(items);
+}
+
+void BVH::BuildTree(std::vector<BVHBuildItem>& items)
+{
+	root = BuildTreeInternal(items);
 	//Logger::Get().Log("Created BVH Tree with root: " + root->boundingBox.ToString());
 }
 
 void BVH::Destroy()
 {
 	Destroy(root);
+	delete root;
 	root = nullptr;
 }
 
 BoxCollider* BVH::CheckCollisions(BoxCollider* boxCollider, ColliderTag colliderTag) const
 {
 	Vector3 _;  // Normal isn't required here
-	return CheckCollisions(root, boxCollider, _, colliderTag);
+	return CheckCollisions(root, boxCollider, _, colliderTag, nullptr);
+}
+
+BoxCollider* BVH::CheckCollisions(BoxCollider* boxCollider, Vector3& normal, ColliderTag colliderTag, const DenseRegistry<Collider*>* registry) const
+{
+	return CheckCollisions(root, boxCollider, normal, colliderTag, registry);
 }
 
 Vector3 BVH::GetCollisionNormal(BoxCollider* boxCollider, ColliderTag colliderTag) const
 {
 	Vector3 collisionNormal;
-	CheckCollisions(root, boxCollider, collisionNormal, colliderTag);
+	CheckCollisions(root, boxCollider, collisionNormal, colliderTag, nullptr);
 	return collisionNormal;
 }
 
+void BVH::QueryOverlaps(const AABB& aabb, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const
+{
+	QueryOverlaps(root, aabb, result, triggers, tagMask);
+}
+
+void BVH::QuerySphereOverlaps(const Vector3& center, float radius, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const
+{
+	QuerySphereOverlaps(root, center, radius, result, triggers, tagMask);
+}
+
+void BVH::CopyTree(const BVH& other)
+{
+	Destroy();
+	root = CopyTree(other.root, nullptr);
+}
+
+size_t BVH::DropRemovedColliders(const DenseRegistry<Collider*>& registry)
+{
+	return DropRemovedColliders(root, registry);
+}
+
 void BVH::RebuildTree()
 {
 	RebuildTree(root);
 	//Logger::Get().Log("New BVH root: " + root->boundingBox.ToString());
 }
 
+size_t BVH::GetMemoryUsage() const
+{
+	return sizeof(BVH) + GetMemoryUsage(root);
+}
+
 //void BVH::AddCollider(BoxCollider* collider)
 //{
 //	if (root == nullptr)
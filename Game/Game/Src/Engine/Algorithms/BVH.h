@@ -9,6 +9,7 @@
 
 #include "Engine/Algorithms/AABB.h"
 #include "Engine/Components/BoxCollider.h"
+#include "Engine/Core/DenseRegistry.h"
 #include "Engine/Math/Vector3.h"
 
 // Node of a BVH tree
@@ -19,6 +20,8 @@ public:
 
 	// Colliders part of this BVH node
 	std::vector<BoxCollider*> colliders;
+	// Collision handles of the colliders. A removed collider can be found without reading it.
+	std::vector<RegistryHandle> colliderHandles;
 
 	BVHNode* parent = nullptr;
 	BVHNode* left = nullptr;
@@ -32,6 +35,15 @@ public:
 	}
 };
 
+// A collider & a copy of its box. A tree built from these doesn't read the colliders,
+// so it can be built on another thread while they keep moving.
+struct BVHBuildItem
+{
+	AABB boundingBox;
+	BoxCollider* collider = nullptr;
+	RegistryHandle handle = INVALID_REGISTRY_HANDLE;
+};
+
 /**
  * @class BVH
  *
@@ -41,19 +53,30 @@ public:
 class BVH
 {
 	friend class TestBVH;
+	friend class QuantizedBVH;
 
 private:
-	BVHNode* root;
+	BVHNode* root = nullptr;
 
 	/**
 	 * @brief Recursively build BVH tree via top-down method.
 	 */
-	BVHNode* BuildTreeInternal(std::vector<BoxCollider*>& colliders);
+	BVHNode* BuildTreeInternal(std::vector<BVHBuildItem>& items);
 
 	/**
 	 * @brief Recursively check for collision.
 	 */
-	BoxCollider* CheckCollisions(BVHNode* node, BoxCollider* collider, Vector3& normal, ColliderTag colliderTag) const;
+	BoxCollider* CheckCollisions(BVHNode* node, BoxCollider* collider, Vector3& normal, ColliderTag colliderTag, const DenseRegistry<Collider*>* registry) const;
+
+	/**
+	 * @brief Recursively collect colliders overlapping the AABB.
+	 */
+	void QueryOverlaps(BVHNode* node, const AABB& aabb, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const;
+
+	/**
+	 * @brief Recursively collect colliders overlapping the sphere.
+	 */
+	void QuerySphereOverlaps(BVHNode* node, const Vector3& center, float radius, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const;
 
 	//bool BVH::AddCollider(BVHNode* node, BoxCollider* collider);
 
@@ -61,28 +84,45 @@ private:
 	 * @brief Compute the AABB enclosing a number of AABBs.
 	 */
 	AABB GetEnclosingBoundingBox(const std::vector<BoxCollider*>& colliders) const;
+	AABB GetEnclosingBoundingBox(const std::vector<BVHBuildItem>& items) const;
 
 	/**
 	 * @brief Split a vector containing colliders into 2 vectors.
 	 * The split is made along the longest axis
 	 */
-	void SplitColliders(std::vector<BoxCollider*>& colliders, AABB& nodeBB, std::vector<BoxCollider*>& left, std::vector<BoxCollider*>& right);
+	void SplitColliders(std::vector<BVHBuildItem>& items, AABB& nodeBB, std::vector<BVHBuildItem>& left, std::vector<BVHBuildItem>& right);
 
 	/**
 	 * @brief Recursively re-build the tree using existign colliders.
 	 */
 	void BVH::RebuildTree(BVHNode* node);
 
+	/**
+	 * @brief Recursively copy the nodes of another tree.
+	 */
+	BVHNode* CopyTree(const BVHNode* node, BVHNode* parent);
+
+	/**
+	 * @brief Recursively drop the colliders whose handles are no longer in the registry.
+	 */
+	size_t DropRemovedColliders(BVHNode* node, const DenseRegistry<Collider*>& registry);
+
 	/**
 	 * @brief Recursively delete all nodes of the tree.
 	 */
 	void Destroy(BVHNode* node);
 
+	size_t GetMemoryUsage(const BVHNode* node) const;
+
 public:
 	/**
 	 * @brief Recursively build BVH tree via top-down method.
 	 */
 	void BuildTree(std::vector<BoxCollider*>& colliders);
+	/**
+	 * @brief Build the tree from copied boxes. Colliders are only stored, never read.
+	 */
+	void BuildTree(std::vector<BVHBuildItem>& items);
 
 	/**
 	 * @brief Empty the tree.
@@ -93,18 +133,56 @@ public:
 	 * @brief Check if anything collided with the input collider.
 	 */
 	BoxCollider* CheckCollisions(BoxCollider* boxCollider, ColliderTag colliderTag = GENERIC) const;
+	/**
+	 * @brief Check if anything collided with the input collider & get the normal to the collision plane.
+	 *
+	 * @param registry If not null, colliders whose handles are no longer in it are skipped (removed since the tree
+	 * was built). They are never read.
+	 */
+	BoxCollider* CheckCollisions(BoxCollider* boxCollider, Vector3& normal, ColliderTag colliderTag = GENERIC, const DenseRegistry<Collider*>* registry = nullptr) const;
 
 	/**
 	 * @brief Get normal vector to the collision plane.
 	 */
 	Vector3 GetCollisionNormal(BoxCollider* boxCollider, ColliderTag colliderTag = GENERIC) const;
 
+	/**
+	 * @brief Append all the colliders overlapping the AABB to the result vector.
+	 * Either only the solid colliders or only the triggers are appended.
+	 *
+	 * @param tagMask Only colliders with these tags are appended
+	 */
+	void QueryOverlaps(const AABB& aabb, std::vector<BoxCollider*>& result, bool triggers = false, ColliderTagMask tagMask = ALL_COLLIDER_TAGS) const;
+
+	/**
+	 * @brief Append all the colliders overlapping the sphere to the result vector.
+	 */
+	void QuerySphereOverlaps(const Vector3& center, float radius, std::vector<BoxCollider*>& result, bool triggers = false, ColliderTagMask tagMask = ALL_COLLIDER_TAGS) const;
+
+	/**
+	 * @brief Replace this tree with a copy of another one. Colliders are shared, nodes are not.
+	 */
+	void CopyTree(const BVH& other);
+
+	/**
+	 * @brief Drop the colliders which were removed from the registry since the tree was built.
+	 * Must be called before RebuildTree, which reads the boxes of all the colliders in the tree.
+	 *
+	 * @return Number of colliders dropped
+	 */
+	size_t DropRemovedColliders(const DenseRegistry<Collider*>& registry);
+
 	/**
 	 * @brief Recursively re-build the tree using existing colliders.
 	 * Useful if the colliders have changed.
 	 */
 	void BVH::RebuildTree();
 
+	/**
+	 * @brief Memory taken by the nodes, in bytes. Useful to compare with QuantizedBVH.
+	 */
+	size_t GetMemoryUsage() const;
+
 	// Decided that the better approach is to just rebuild the tree
 	// Explanation in CollisionSystem::Update()
 	// Not deleting this in case I need them later.
@@ -0,0 +1,465 @@
+// @file: BroadphaseBenchmark.cpp
+//
+// @brief: Cpp file for BroadphaseBenchmark class, which replays a broadphase recording against
+// different broadphases & compares them.
+
+#include "stdafx.h"
+#include "Engine/Algorithms/BroadphaseBenchmark.h"
+#include "Engine/Algorithms/BVH.h"
+#include "Engine/Algorithms/QuantizedBVH.h"
+#include "Engine/Components/BoxCollider.h"
+#include "Engine/Core/Logger.h"
+
+using BenchmarkClock = std::chrono::high_resolution_clock;
+
+static float ElapsedMs(const BenchmarkClock::time_point& start)
+{
+	return std::chrono::duration<float, std::milli>(BenchmarkClock::now() - start).count();
+}
+
+// --------------------------- Broadphases ---------------------------
+
+/**
+ * BVH built from scratch every frame (what CollisionSystem does when colliders get added / removed).
+ */
+class BVHRebuildBroadphase : public ReplayBroadphase
+{
+protected:
+	BVH tree;
+	// BVH stores colliders, so every replayed box gets one. They are reused across frames.
+	std::vector<std::unique_ptr<BoxCollider>> colliders;
+	size_t colliderCount = 0;
+	std::vector<BVHBuildItem> buildItems;
+	std::vector<BoxCollider*> queryResult;
+
+	virtual void QueryBox(const AABB& box, std::vector<BoxCollider*>& result) const
+	{
+		tree.QueryOverlaps(box, result);
+	}
+
+	void SetBoxes(const RecordedBox* boxes, size_t count)
+	{
+		while (colliders.size() < count)
+			colliders.push_back(std::make_unique<BoxCollider>());
+		for (size_t i = 0; i < count; i++)
+			colliders[i]->boundingBox = boxes[i].boundingBox;
+		colliderCount = count;
+	}
+
+public:
+	~BVHRebuildBroadphase() override { tree.Destroy(); }
+
+	const char* GetName() const override { return "BVH rebuild"; }
+
+	void Build(const RecordedBox* boxes, size_t count) override
+	{
+		SetBoxes(boxes, count);
+		buildItems.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			buildItems[i].boundingBox = boxes[i].boundingBox;
+			buildItems[i].collider = colliders[i].get();
+		}
+		tree.Destroy();
+		tree.BuildTree(buildItems);
+	}
+
+	void Update(const RecordedBox* boxes, size_t count) override
+	{
+		Build(boxes, count);
+	}
+
+	size_t CountPairs() override
+	{
+		size_t pairs = 0;
+		for (size_t i = 0; i < colliderCount; i++)
+		{
+			BoxCollider* boxC = colliders[i].get();
+			queryResult.clear();
+			QueryBox(boxC->boundingBox, queryResult);
+			// A pair is found from both of its boxes (& a box finds itself), so it's counted from one side only
+			for (BoxCollider* other : queryResult)
+			{
+				if (std::less<BoxCollider*>()(boxC, other))
+					++pairs;
+			}
+		}
+		return pairs;
+	}
+};
+
+/**
+ * BVH built once & refit every frame (what CollisionSystem does when boxes only move).
+ */
+class BVHRefitBroadphase : public BVHRebuildBroadphase
+{
+public:
+	const char* GetName() const override { return "BVH refit"; }
+
+	void Update(const RecordedBox* boxes, size_t count) override
+	{
+		SetBoxes(boxes, count);
+		tree.RebuildTree();
+	}
+};
+
+/**
+ * BVH refit every frame & compressed into a QuantizedBVH, which the queries use.
+ */
+class QuantizedBVHBroadphase : public BVHRefitBroadphase
+{
+	QuantizedBVH quantizedTree;
+
+	void QueryBox(const AABB& box, std::vector<BoxCollider*>& result) const override
+	{
+		quantizedTree.QueryOverlaps(box, result);
+	}
+
+public:
+	const char* GetName() const override { return "Quantized BVH"; }
+
+	void Build(const RecordedBox* boxes, size_t count) override
+	{
+		BVHRefitBroadphase::Build(boxes, count);
+		quantizedTree.Build(tree);
+	}
+
+	void Update(const RecordedBox* boxes, size_t count) override
+	{
+		BVHRefitBroadphase::Update(boxes, count);
+		quantizedTree.Build(tree);
+	}
+};
+
+/**
+ * Uniform grid stored in a hash map, so that it doesn't need bounds. Rebuilt every frame.
+ * Boxes covering too many cells (like floors) are kept aside & checked against all the others.
+ */
+class HashGridBroadphase : public ReplayBroadphase
+{
+	static const int MAX_CELLS_PER_BOX = 64;
+
+	// Picked from the first frame if not given
+	float cellSize = 0.0f;
+	std::vector<AABB> boxes;
+	std::vector<bool> isLarge;
+	std::vector<unsigned int> largeBoxes;
+	std::unordered_map<unsigned long long, std::vector<unsigned int>> cells;
+
+	int CellCoord(float value) const
+	{
+		return static_cast<int>(std::floor(value / cellSize));
+	}
+
+	static unsigned long long CellKey(int x, int y, int z)
+	{
+		// 21 bits per axis
+		const unsigned long long mask = (1ull << 21) - 1;
+		return ((static_cast<unsigned long long>(x) & mask) << 42) |
+			   ((static_cast<unsigned long long>(y) & mask) << 21) |
+			   (static_cast<unsigned long long>(z) & mask);
+	}
+
+	void Insert(const RecordedBox* recorded, size_t count)
+	{
+		// Cells are kept (with their memory), only emptied
+		for (auto& cell : cells)
+			cell.second.clear();
+		largeBoxes.clear();
+		boxes.resize(count);
+		isLarge.assign(count, false);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const AABB& box = recorded[i].boundingBox;
+			boxes[i] = box;
+
+			// Counted in floats first, a huge box would overflow the cell coordinates
+			float cellsX = std::floor(box.maxCoords.x / cellSize) - std::floor(box.minCoords.x / cellSize) + 1.0f;
+			float cellsY = std::floor(box.maxCoords.y / cellSize) - std::floor(box.minCoords.y / cellSize) + 1.0f;
+			float cellsZ = std::floor(box.maxCoords.z / cellSize) - std::floor(box.minCoords.z / cellSize) + 1.0f;
+			if (cellsX * cellsY * cellsZ > MAX_CELLS_PER_BOX)
+			{
+				isLarge[i] = true;
+				largeBoxes.push_back(i);
+				continue;
+			}
+
+			for (int x = CellCoord(box.minCoords.x); x <= CellCoord(box.maxCoords.x); x++)
+				for (int y = CellCoord(box.minCoords.y); y <= CellCoord(box.maxCoords.y); y++)
+					for (int z = CellCoord(box.minCoords.z); z <= CellCoord(box.maxCoords.z); z++)
+						cells[CellKey(x, y, z)].push_back(i);
+		}
+	}
+
+public:
+	explicit HashGridBroadphase(float size = 0.0f) : cellSize(size) {}
+
+	const char* GetName() const override { return "Hash grid"; }
+
+	void Build(const RecordedBox* recorded, size_t count) override
+	{
+		if (cellSize <= 0.0f)
+		{
+			// About the size of an average box
+			float extentSum = 0.0f;
+			for (size_t i = 0; i < count; i++)
+			{
+				Vector3 extents = recorded[i].boundingBox.maxCoords - recorded[i].boundingBox.minCoords;
+				extentSum += std::max(extents.x, std::max(extents.y, extents.z));
+			}
+			cellSize = (count > 0) ? std::max(1.0f, extentSum / count) : 1.0f;
+		}
+
+		cells.clear();
+		Insert(recorded, count);
+	}
+
+	void Update(const RecordedBox* recorded, size_t count) override
+	{
+		Insert(recorded, count);
+	}
+
+	size_t CountPairs() override
+	{
+		size_t pairs = 0;
+		for (const auto& cell : cells)
+		{
+			const std::vector<unsigned int>& items = cell.second;
+			for (size_t i = 0; i < items.size(); i++)
+			{
+				const AABB& a = boxes[items[i]];
+				for (size_t j = i + 1; j < items.size(); j++)
+				{
+					const AABB& b = boxes[items[j]];
+					if (!a.Intersects(b))
+						continue;
+
+					// Overlapping boxes share many cells. The pair is counted only in the cell
+					// holding the min corner of their overlap.
+					unsigned long long homeCell = CellKey(CellCoord(std::max(a.minCoords.x, b.minCoords.x)),
+														  CellCoord(std::max(a.minCoords.y, b.minCoords.y)),
+														  CellCoord(std::max(a.minCoords.z, b.minCoords.z)));
+					if (homeCell == cell.first)
+						++pairs;
+				}
+			}
+		}
+
+		for (unsigned int large : largeBoxes)
+		{
+			for (unsigned int i = 0; i < boxes.size(); i++)
+			{
+				// Pairs of two large boxes are counted from the first one
+				if (i != large && (!isLarge[i] || i > large) && boxes[large].Intersects(boxes[i]))
+					++pairs;
+			}
+		}
+		return pairs;
+	}
+};
+
+/**
+ * Sweep and prune along X. Boxes stay sorted between frames, so an insertion sort catches up quickly.
+ */
+class SweepAndPruneBroadphase : public ReplayBroadphase
+{
+	std::vector<AABB> boxes;
+	// Box indices sorted by min x
+	std::vector<unsigned int> order;
+
+	void SetBoxes(const RecordedBox* recorded, size_t count)
+	{
+		boxes.resize(count);
+		for (size_t i = 0; i < count; i++)
+			boxes[i] = recorded[i].boundingBox;
+	}
+
+public:
+	const char* GetName() const override { return "Sweep and prune"; }
+
+	void Build(const RecordedBox* recorded, size_t count) override
+	{
+		SetBoxes(recorded, count);
+		order.resize(count);
+		for (unsigned int i = 0; i < count; i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+			return boxes[a].minCoords.x < boxes[b].minCoords.x;
+		});
+	}
+
+	void Update(const RecordedBox* recorded, size_t count) override
+	{
+		SetBoxes(recorded, count);
+		for (size_t i = 1; i < order.size(); i++)
+		{
+			unsigned int item = order[i];
+			size_t j = i;
+			for (; j > 0 && boxes[order[j - 1]].minCoords.x > boxes[item].minCoords.x; j--)
+				order[j] = order[j - 1];
+			order[j] = item;
+		}
+	}
+
+	size_t CountPairs() override
+	{
+		size_t pairs = 0;
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			const AABB& a = boxes[order[i]];
+			// Boxes starting after this one ends can't overlap it
+			for (size_t j = i + 1; j < order.size() && boxes[order[j]].minCoords.x <= a.maxCoords.x; j++)
+			{
+				if (a.Intersects(boxes[order[j]]))
+					++pairs;
+			}
+		}
+		return pairs;
+	}
+};
+
+// --------------------------- Benchmark ---------------------------
+
+BroadphaseBenchmark::BroadphaseBenchmark()
+{
+	AddBroadphase(std::make_unique<BVHRebuildBroadphase>());
+	AddBroadphase(std::make_unique<BVHRefitBroadphase>());
+	AddBroadphase(std::make_unique<QuantizedBVHBroadphase>());
+	AddBroadphase(std::make_unique<HashGridBroadphase>());
+	AddBroadphase(std::make_unique<SweepAndPruneBroadphase>());
+}
+
+void BroadphaseBenchmark::AddBroadphase(std::unique_ptr<ReplayBroadphase> broadphase)
+{
+	Entry entry;
+	entry.broadphase = std::move(broadphase);
+	entries.push_back(std::move(entry));
+}
+
+bool BroadphaseBenchmark::Run(const BroadphaseRecording& recording)
+{
+	frameBoxCounts.clear();
+	for (Entry& entry : entries)
+		entry.frames.clear();
+
+	bool pairsMatch = true;
+	std::vector<unsigned int> lastIds;
+	for (size_t frame = 0; frame < recording.GetFrameCount(); frame++)
+	{
+		const RecordedBox* boxes = recording.GetFrame(frame);
+		size_t count = recording.GetBoxCount(frame);
+		frameBoxCounts.push_back(count);
+
+		// Adding or removing a collider changes the ids at some position, so comparing them in order is enough
+		bool sameColliders = (frame > 0 && count == lastIds.size());
+		for (size_t i = 0; sameColliders && i < count; i++)
+			sameColliders = (boxes[i].id == lastIds[i]);
+		lastIds.resize(count);
+		for (size_t i = 0; i < count; i++)
+			lastIds[i] = boxes[i].id;
+
+		for (Entry& entry : entries)
+		{
+			BroadphaseFrameResult result;
+			BenchmarkClock::time_point start = BenchmarkClock::now();
+			if (sameColliders)
+			{
+				entry.broadphase->Update(boxes, count);
+				result.updateTime = ElapsedMs(start);
+			}
+			else
+			{
+				entry.broadphase->Build(boxes, count);
+				result.isBuild = true;
+				result.buildTime = ElapsedMs(start);
+			}
+
+			start = BenchmarkClock::now();
+			result.pairs = entry.broadphase->CountPairs();
+			result.queryTime = ElapsedMs(start);
+			entry.frames.push_back(result);
+
+			if (pairsMatch && result.pairs != entries[0].frames.back().pairs)
+			{
+				pairsMatch = false;
+				Logger::Get().Log("Broadphase benchmark frame " + std::to_string(frame) + ": " + entry.broadphase->GetName() +
+								  " found " + std::to_string(result.pairs) + " pairs, " + entries[0].broadphase->GetName() +
+								  " found " + std::to_string(entries[0].frames.back().pairs), WARNING_LOG);
+			}
+		}
+	}
+	return pairsMatch;
+}
+
+void BroadphaseBenchmark::LogSummary() const
+{
+	if (frameBoxCounts.empty())
+	{
+		Logger::Get().Log("Broadphase benchmark has no frames", WARNING_LOG);
+		return;
+	}
+
+	size_t boxSum = 0;
+	for (size_t count : frameBoxCounts)
+		boxSum += count;
+	Logger::Get().Log("Broadphase benchmark: " + std::to_string(frameBoxCounts.size()) + " frames, " +
+					  std::to_string(boxSum / frameBoxCounts.size()) + " boxes per frame on average");
+
+	for (const Entry& entry : entries)
+	{
+		float buildSum = 0.0f, updateSum = 0.0f, querySum = 0.0f, worstFrame = 0.0f;
+		size_t builds = 0, pairSum = 0;
+		for (const BroadphaseFrameResult& result : entry.frames)
+		{
+			if (result.isBuild)
+				++builds;
+			buildSum += result.buildTime;
+			updateSum += result.updateTime;
+			querySum += result.queryTime;
+			pairSum += result.pairs;
+			worstFrame = std::max(worstFrame, result.buildTime + result.updateTime + result.queryTime);
+		}
+		size_t frames = entry.frames.size();
+		size_t updates = frames - builds;
+
+		std::ostringstream summary;
+		summary << std::fixed << std::setprecision(3) << "  " << entry.broadphase->GetName()
+				<< ": build " << (builds > 0 ? buildSum / builds : 0.0f) << " ms (" << builds << " builds)"
+				<< ", update " << (updates > 0 ? updateSum / updates : 0.0f) << " ms"
+				<< ", query " << querySum / frames << " ms"
+				<< ", worst frame " << worstFrame << " ms"
+				<< ", " << pairSum / frames << " pairs per frame";
+		Logger::Get().Log(summary.str());
+	}
+}
+
+bool BroadphaseBenchmark::SaveCSV(const std::string& filename) const
+{
+	std::ofstream file(filename);
+	if (!file.is_open())
+	{
+		Logger::Get().Log("Could not write broadphase benchmark results to " + filename, ERROR_LOG);
+		return false;
+	}
+
+	file << "frame,boxes";
+	for (const Entry& entry : entries)
+	{
+		std::string name = entry.broadphase->GetName();
+		file << "," << name << " build ms," << name << " update ms," << name << " query ms," << name << " pairs";
+	}
+	file << "\n";
+
+	for (size_t frame = 0; frame < frameBoxCounts.size(); frame++)
+	{
+		file << frame << "," << frameBoxCounts[frame];
+		for (const Entry& entry : entries)
+		{
+			const BroadphaseFrameResult& result = entry.frames[frame];
+			file << "," << result.buildTime << "," << result.updateTime << "," << result.queryTime << "," << result.pairs;
+		}
+		file << "\n";
+	}
+	return true;
+}
@@ -0,0 +1,102 @@
+// @file: BroadphaseBenchmark.h
+//
+// @brief: Header file for BroadphaseBenchmark class, which replays a broadphase recording against
+// different broadphases & compares them.
+
+#pragma once
+#ifndef _BROADPHASE_BENCHMARK_H_
+#define _BROADPHASE_BENCHMARK_H_
+
+#include "Engine/Algorithms/BroadphaseRecording.h"
+
+// Result of a broadphase for one recorded frame. Times are in ms.
+struct BroadphaseFrameResult
+{
+	// Built from scratch in this frame? Otherwise it was updated.
+	bool isBuild = false;
+	float buildTime = 0.0f;
+	float updateTime = 0.0f;
+	float queryTime = 0.0f;
+	// Overlapping box pairs found
+	size_t pairs = 0;
+};
+
+/**
+ * @class ReplayBroadphase
+ *
+ * A broadphase which can be benchmarked. It gets the boxes of every recorded frame in order.
+ */
+class ReplayBroadphase
+{
+public:
+	virtual ~ReplayBroadphase() = default;
+
+	virtual const char* GetName() const = 0;
+
+	/**
+	 * @brief Build from scratch. Called on the first frame & whenever colliders got added or removed.
+	 */
+	virtual void Build(const RecordedBox* boxes, size_t count) = 0;
+
+	/**
+	 * @brief Catch up with the boxes of the next frame.
+	 * Colliders are the same as in the previous frame & in the same order, only their boxes changed.
+	 */
+	virtual void Update(const RecordedBox* boxes, size_t count) = 0;
+
+	/**
+	 * @brief Find all pairs of overlapping boxes.
+	 * @return Number of pairs, each pair counted once.
+	 */
+	virtual size_t CountPairs() = 0;
+};
+
+/**
+ * @class BroadphaseBenchmark
+ *
+ * Replays recorded gameplay (see CollisionSystem::StartRecording) against each broadphase,
+ * so that they can be compared on the real workload instead of random boxes.
+ * Every broadphase must find the same pairs, so pair counts double as a correctness check.
+ */
+class BroadphaseBenchmark
+{
+	struct Entry
+	{
+		std::unique_ptr<ReplayBroadphase> broadphase;
+		std::vector<BroadphaseFrameResult> frames;
+	};
+	std::vector<Entry> entries;
+	// Number of boxes in every replayed frame
+	std::vector<size_t> frameBoxCounts;
+
+public:
+	/**
+	 * @brief Set up the benchmark with all the available broadphases:
+	 * BVH rebuilt every frame, BVH refit every frame, quantized BVH, hash grid & sweep and prune.
+	 */
+	BroadphaseBenchmark();
+
+	void AddBroadphase(std::unique_ptr<ReplayBroadphase> broadphase);
+
+	/**
+	 * @brief Replay all frames of the recording against every broadphase.
+	 * @return False if the broadphases didn't find the same number of pairs.
+	 */
+	bool Run(const BroadphaseRecording& recording);
+
+	size_t GetBroadphaseCount() const { return entries.size(); }
+	const char* GetName(size_t index) const { return entries[index].broadphase->GetName(); }
+	const std::vector<BroadphaseFrameResult>& GetResults(size_t index) const { return entries[index].frames; }
+
+	/**
+	 * @brief Log the average & worst frame times of every broadphase.
+	 */
+	void LogSummary() const;
+
+	/**
+	 * @brief Save the results of every frame as CSV, one row per frame.
+	 */
+	bool SaveCSV(const std::string& filename) const;
+};
+
+#endif // !_BROADPHASE_BENCHMARK_H_
@@ -0,0 +1,86 @@
+// @file: BroadphaseRecording.cpp
+//
+// @brief: Cpp file for BroadphaseRecording class, per-frame collider boxes captured from gameplay.
+
+#include "stdafx.h"
+#include "Engine/Algorithms/BroadphaseRecording.h"
+#include "Engine/Core/Logger.h"
+
+static const char FILE_MAGIC[4] = { 'B', 'P', 'R', 'C' };
+
+void BroadphaseRecording::WriteHeader(std::ofstream& file)
+{
+	file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+	unsigned int version = FILE_VERSION;
+	file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+}
+
+void BroadphaseRecording::WriteFrame(std::ofstream& file, const std::vector<RecordedBox>& frame)
+{
+	unsigned int count = static_cast<unsigned int>(frame.size());
+	file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	for (const RecordedBox& box : frame)
+	{
+		file.write(reinterpret_cast<const char*>(&box.id), sizeof(box.id));
+		// Vector3 has a w component, which isn't needed
+		file.write(reinterpret_cast<const char*>(&box.boundingBox.minCoords.x), 3 * sizeof(float));
+		file.write(reinterpret_cast<const char*>(&box.boundingBox.maxCoords.x), 3 * sizeof(float));
+	}
+}
+
+bool BroadphaseRecording::Load(const std::string& filename)
+{
+	Clear();
+
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		Logger::Get().Log("Could not open broadphase recording " + filename, ERROR_LOG);
+		return false;
+	}
+
+	char magic[4];
+	unsigned int version = 0;
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	if (!file || !std::equal(magic, magic + sizeof(magic), FILE_MAGIC) || version != FILE_VERSION)
+	{
+		Logger::Get().Log(filename + " is not a broadphase recording", ERROR_LOG);
+		return false;
+	}
+
+	std::vector<RecordedBox> frame;
+	unsigned int count = 0;
+	while (file.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	{
+		frame.resize(count);
+		for (RecordedBox& box : frame)
+		{
+			file.read(reinterpret_cast<char*>(&box.id), sizeof(box.id));
+			file.read(reinterpret_cast<char*>(&box.boundingBox.minCoords.x), 3 * sizeof(float));
+			file.read(reinterpret_cast<char*>(&box.boundingBox.maxCoords.x), 3 * sizeof(float));
+		}
+		// Game may have quit in the middle of writing a frame
+		if (!file)
+		{
+			Logger::Get().Log("Broadphase recording " + filename + " ends with an incomplete frame", WARNING_LOG);
+			break;
+		}
+		AddFrame(frame);
+	}
+
+	Logger::Get().Log("Loaded " + std::to_string(GetFrameCount()) + " frames from broadphase recording " + filename);
+	return true;
+}
+
+void BroadphaseRecording::AddFrame(const std::vector<RecordedBox>& frame)
+{
+	boxes.insert(boxes.end(), frame.begin(), frame.end());
+	frameStarts.push_back(boxes.size());
+}
+
+void BroadphaseRecording::Clear()
+{
+	boxes.clear();
+	frameStarts.assign(1, 0);
+}
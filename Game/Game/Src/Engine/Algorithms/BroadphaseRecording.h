@@ -0,0 +1,59 @@
+// @file: BroadphaseRecording.h
+//
+// @brief: Header file for BroadphaseRecording class, per-frame collider boxes captured from gameplay.
+
+#pragma once
+#ifndef _BROADPHASE_RECORDING_H_
+#define _BROADPHASE_RECORDING_H_
+
+#include "Engine/Algorithms/AABB.h"
+
+// Box of a collider in a recorded frame
+struct RecordedBox
+{
+	// Same for a collider in all the frames it is alive
+	unsigned int id = 0;
+	AABB boundingBox;
+};
+
+/**
+ * @class BroadphaseRecording
+ *
+ * Boxes of all the colliders, frame by frame, so that broadphases can be compared on the real workload.
+ *
+ * File layout (little endian):
+ *     Header: "BPRC", version (uint32)
+ *     Frame:  box count (uint32), then for each box: id (uint32), min xyz, max xyz (6 floats)
+ * Frames follow the header till the end of the file, so a recording can be written while the game runs.
+ */
+class BroadphaseRecording
+{
+	static const unsigned int FILE_VERSION = 1;
+
+	// Boxes of all frames, one frame after the other
+	std::vector<RecordedBox> boxes;
+	// Index of the first box of every frame, plus the end of the last frame
+	std::vector<size_t> frameStarts{ 0 };
+
+public:
+	/**
+	 * @brief Write the file header. Must be done once before writing frames.
+	 */
+	static void WriteHeader(std::ofstream& file);
+	static void WriteFrame(std::ofstream& file, const std::vector<RecordedBox>& frame);
+
+	/**
+	 * @brief Replace the recording with the one in a file.
+	 * @return False if the file is missing or isn't a recording. A cut off last frame is dropped.
+	 */
+	bool Load(const std::string& filename);
+
+	void AddFrame(const std::vector<RecordedBox>& frame);
+	void Clear();
+
+	size_t GetFrameCount() const { return frameStarts.size() - 1; }
+	size_t GetBoxCount(size_t frame) const { return frameStarts[frame + 1] - frameStarts[frame]; }
+	const RecordedBox* GetFrame(size_t frame) const { return boxes.data() + frameStarts[frame]; }
+};
+
+#endif // !_BROADPHASE_RECORDING_H_
@@ -0,0 +1,186 @@
+// @file: QuantizedBVH.cpp
+//
+// @brief: Cpp file for QuantizedBVH class, a compact read-only copy of a BVH tree.
+
+#include "stdafx.h"
+#include "Engine/Algorithms/QuantizedBVH.h"
+#include "Engine/Algorithms/BVH.h"
+#include "Engine/Components/BoxCollider.h"
+
+static_assert(sizeof(QuantizedBVHNode) == 32, "QuantizedBVHNode must fit in half a cache line");
+
+// --------------------------- Private member functions ---------------------------
+
+unsigned int QuantizedBVH::MakeLeafRef(size_t firstCollider, size_t count)
+{
+	assert(count <= LEAF_COUNT_MASK);
+	assert(firstCollider < (LEAF_FLAG >> LEAF_COUNT_BITS));
+	return LEAF_FLAG | (static_cast<unsigned int>(firstCollider) << LEAF_COUNT_BITS) | static_cast<unsigned int>(count);
+}
+
+unsigned int QuantizedBVH::AddNode(const BVHNode* node, const AABB& box)
+{
+	if (node->IsLeaf())
+	{
+		unsigned int leafRef = MakeLeafRef(leafColliders.size(), node->colliders.size());
+		leafColliders.insert(leafColliders.end(), node->colliders.begin(), node->colliders.end());
+		return leafRef;
+	}
+
+	unsigned int index = static_cast<unsigned int>(nodes.size());
+	nodes.push_back(QuantizedBVHNode());
+
+	const BVHNode* children[2] = { node->left, node->right };
+	for (int c = 0; c < 2; c++)
+	{
+		if (children[c] == nullptr)
+		{
+			nodes[index].children[c] = EMPTY_CHILD;
+			continue;
+		}
+
+		// Children are quantized inside the box queries see, so that rounding never adds up to a miss
+		AABB childBox = Quantize(children[c]->boundingBox, box, nodes[index].childMin[c], nodes[index].childMax[c]);
+		// Adding the subtree can move the nodes, so the child is set after it
+		unsigned int childRef = AddNode(children[c], childBox);
+		nodes[index].children[c] = childRef;
+	}
+	return index;
+}
+
+AABB QuantizedBVH::Quantize(const AABB& child, const AABB& parent, unsigned short* qMin, unsigned short* qMax)
+{
+	const float* childMin = &child.minCoords.x;
+	const float* childMax = &child.maxCoords.x;
+	const float* parentMin = &parent.minCoords.x;
+	const float* parentMax = &parent.maxCoords.x;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float extent = parentMax[axis] - parentMin[axis];
+		if (extent <= 0.0f)
+		{
+			qMin[axis] = 0;
+			qMax[axis] = QUANTIZED_MAX;
+			continue;
+		}
+
+		float scale = QUANTIZED_MAX / extent;
+		float low = std::floor((childMin[axis] - parentMin[axis]) * scale);
+		float high = std::ceil((childMax[axis] - parentMin[axis]) * scale);
+		unsigned short qLow = static_cast<unsigned short>(std::min(std::max(low, 0.0f), static_cast<float>(QUANTIZED_MAX)));
+		unsigned short qHigh = static_cast<unsigned short>(std::min(std::max(high, 0.0f), static_cast<float>(QUANTIZED_MAX)));
+
+		// Float rounding can still land a step inside the child box
+		while (qLow > 0 && DequantizeValue(qLow, parentMin[axis], parentMax[axis]) > childMin[axis])
+			--qLow;
+		while (qHigh < QUANTIZED_MAX && DequantizeValue(qHigh, parentMin[axis], parentMax[axis]) < childMax[axis])
+			++qHigh;
+
+		qMin[axis] = qLow;
+		qMax[axis] = qHigh;
+	}
+
+	return Dequantize(qMin, qMax, parent);
+}
+
+AABB QuantizedBVH::Dequantize(const unsigned short* qMin, const unsigned short* qMax, const AABB& parent)
+{
+	return AABB(Vector3(DequantizeValue(qMin[0], parent.minCoords.x, parent.maxCoords.x),
+						DequantizeValue(qMin[1], parent.minCoords.y, parent.maxCoords.y),
+						DequantizeValue(qMin[2], parent.minCoords.z, parent.maxCoords.z)),
+				Vector3(DequantizeValue(qMax[0], parent.minCoords.x, parent.maxCoords.x),
+						DequantizeValue(qMax[1], parent.minCoords.y, parent.maxCoords.y),
+						DequantizeValue(qMax[2], parent.minCoords.z, parent.maxCoords.z)));
+}
+
+float QuantizedBVH::DequantizeValue(unsigned short value, float min, float max)
+{
+	// Top end is exact, so a child can always cover its whole parent
+	if (value == QUANTIZED_MAX)
+		return max;
+	return min + (max - min) * (value / static_cast<float>(QUANTIZED_MAX));
+}
+
+template <typename OverlapTest>
+void QuantizedBVH::Query(OverlapTest overlaps, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const
+{
+	if (rootRef == EMPTY_CHILD || !overlaps(rootBox))
+		return;
+
+	// Nodes left to visit, with their boxes
+	struct StackEntry
+	{
+		unsigned int ref;
+		AABB box;
+	};
+	StackEntry stack[MAX_QUERY_DEPTH];
+	size_t stackSize = 0;
+	stack[stackSize++] = { rootRef, rootBox };
+
+	while (stackSize > 0)
+	{
+		StackEntry entry = stack[--stackSize];
+		if (entry.ref & LEAF_FLAG)
+		{
+			size_t first = (entry.ref & ~LEAF_FLAG) >> LEAF_COUNT_BITS;
+			size_t count = entry.ref & LEAF_COUNT_MASK;
+			for (size_t i = first; i < first + count; i++)
+			{
+				BoxCollider* leafC = leafColliders[i];
+				if (leafC->IsTrigger() == triggers && (tagMask & ColliderTagBit(leafC->GetColliderTag())) &&
+					overlaps(leafC->boundingBox))
+					result.push_back(leafC);
+			}
+			continue;
+		}
+
+		const QuantizedBVHNode& node = nodes[entry.ref];
+		for (int c = 0; c < 2; c++)
+		{
+			if (node.children[c] == EMPTY_CHILD)
+				continue;
+
+			AABB childBox = Dequantize(node.childMin[c], node.childMax[c], entry.box);
+			if (overlaps(childBox))
+			{
+				assert(stackSize < MAX_QUERY_DEPTH);
+				stack[stackSize++] = { node.children[c], childBox };
+			}
+		}
+	}
+}
+
+// --------------------------- Public member functions ---------------------------
+
+void QuantizedBVH::Build(const BVH& tree)
+{
+	Clear();
+	if (tree.root == nullptr)
+		return;
+
+	rootBox = tree.root->boundingBox;
+	rootRef = AddNode(tree.root, rootBox);
+}
+
+void QuantizedBVH::Clear()
+{
+	nodes.clear();
+	leafColliders.clear();
+	rootRef = EMPTY_CHILD;
+}
+
+void QuantizedBVH::QueryOverlaps(const AABB& aabb, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const
+{
+	Query([&aabb](const AABB& box) { return box.Intersects(aabb); }, result, triggers, tagMask);
+}
+
+void QuantizedBVH::QuerySphereOverlaps(const Vector3& center, float radius, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const
+{
+	Query([&center, radius](const AABB& box) { return box.IntersectsSphere(center, radius); }, result, triggers, tagMask);
+}
+
+size_t QuantizedBVH::GetMemoryUsage() const
+{
+	return sizeof(QuantizedBVH) + nodes.capacity() * sizeof(QuantizedBVHNode) + leafColliders.capacity() * sizeof(BoxCollider*);
+}
@@ -0,0 +1,101 @@
+// @file: QuantizedBVH.h
+//
+// @brief: Header file for QuantizedBVH class, a compact read-only copy of a BVH tree.
+
+#pragma once
+#ifndef _QUANTIZED_BVH_H_
+#define _QUANTIZED_BVH_H_
+
+#include "Engine/Algorithms/AABB.h"
+#include "Engine/Components/Collider.h"
+
+class BVH;
+class BVHNode;
+class BoxCollider;
+
+// Both children of a BVH node. Child boxes are stored relative to the node's box. 32 bytes.
+struct QuantizedBVHNode
+{
+	// Child boxes in steps of 1 / 65535 of the node box, rounded outwards.
+	// Stored boxes are never smaller than the real ones, so queries can't miss anything.
+	unsigned short childMin[2][3];
+	unsigned short childMax[2][3];
+	// Node index of the child, or a leaf (see QuantizedBVH::MakeLeafRef)
+	unsigned int children[2];
+};
+
+/**
+ * @class QuantizedBVH
+ *
+ * A BVHNode takes about 80 bytes (full float bounds, a collider vector & 3 pointers) & every node is a separate
+ * allocation, so a large tree spends most of a query on cache misses. QuantizedBVH stores the same tree in a flat
+ * array of 32 byte nodes, with the child boxes as 16-bit offsets inside the parent box. Only the root box is kept in floats.
+ * Colliders of the leaves are stored back to back in one vector.
+ *
+ * It can't be refit, so it gets built again from a BVH whenever that one changes.
+ */
+class QuantizedBVH
+{
+	friend class TestQuantizedBVH;
+
+	static const unsigned int EMPTY_CHILD = 0xFFFFFFFF;
+	static const unsigned int LEAF_FLAG = 0x80000000;
+	// Lower bits of a leaf are its collider count, the rest is its first collider
+	static const unsigned int LEAF_COUNT_BITS = 5;
+	static const unsigned int LEAF_COUNT_MASK = (1u << LEAF_COUNT_BITS) - 1;
+	static const unsigned short QUANTIZED_MAX = 0xFFFF;
+	// Deep enough for any tree built by BVH (it splits in halves)
+	static const size_t MAX_QUERY_DEPTH = 64;
+
+	AABB rootBox;
+	unsigned int rootRef = EMPTY_CHILD;
+	std::vector<QuantizedBVHNode> nodes;
+	std::vector<BoxCollider*> leafColliders;
+
+	static unsigned int MakeLeafRef(size_t firstCollider, size_t count);
+
+	/**
+	 * @brief Recursively add a node & its subtree.
+	 *
+	 * @param box Box of the node as queries will see it (its quantized box, not the original)
+	 * @return Reference to the node
+	 */
+	unsigned int AddNode(const BVHNode* node, const AABB& box);
+
+	/**
+	 * @brief Store a child box relative to the parent box, rounded outwards.
+	 * @return Box of the child as queries will see it.
+	 */
+	static AABB Quantize(const AABB& child, const AABB& parent, unsigned short* qMin, unsigned short* qMax);
+	static AABB Dequantize(const unsigned short* qMin, const unsigned short* qMax, const AABB& parent);
+	static float DequantizeValue(unsigned short value, float min, float max);
+
+	/**
+	 * @brief Collect the colliders passing the overlap test, walking the tree without recursion.
+	 */
+	template <typename OverlapTest>
+	void Query(OverlapTest overlaps, std::vector<BoxCollider*>& result, bool triggers, ColliderTagMask tagMask) const;
+
+public:
+	/**
+	 * @brief Replace this tree with a compressed copy of a BVH. Colliders are shared.
+	 */
+	void Build(const BVH& tree);
+	void Clear();
+
+	/**
+	 * @brief Append all the colliders overlapping the AABB to the result vector. Same as BVH::QueryOverlaps.
+	 */
+	void QueryOverlaps(const AABB& aabb, std::vector<BoxCollider*>& result, bool triggers = false, ColliderTagMask tagMask = ALL_COLLIDER_TAGS) const;
+
+	/**
+	 * @brief Append all the colliders overlapping the sphere to the result vector. Same as BVH::QuerySphereOverlaps.
+	 */
+	void QuerySphereOverlaps(const Vector3& center, float radius, std::vector<BoxCollider*>& result, bool triggers = false, ColliderTagMask tagMask = ALL_COLLIDER_TAGS) const;
+
+	size_t GetNodeCount() const { return nodes.size(); }
+	// In bytes
+	size_t GetMemoryUsage() const;
+};
+
+#endif // !_QUANTIZED_BVH_H_
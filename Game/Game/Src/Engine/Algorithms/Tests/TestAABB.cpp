@@ -11,6 +11,10 @@
 void TestAABB::RunTests()
 {
 	TestIntersects();
+	TestIntersectsSphere();
+	TestContains();
+	TestMerge();
+	TestGetPenetration();
 	TestToString();
 	Logger::Get().Log("[UNITTEST] AABB - All tests passed!");
 }
@@ -25,6 +29,63 @@ void TestAABB::TestIntersects()
 	assert(aabb1.Intersects(aabb3));
 }
 
+void TestAABB::TestIntersectsSphere()
+{
+	AABB aabb{ Vector3(0.0f, 0.0f, 0.0f), Vector3(5.0f, 5.0f, 5.0f) };
+
+	// Center inside
+	assert(aabb.IntersectsSphere(Vector3(2.0f, 2.0f, 2.0f), 0.5f));
+	// Touching a face
+	assert(aabb.IntersectsSphere(Vector3(7.0f, 2.0f, 2.0f), 2.0f));
+	assert(!aabb.IntersectsSphere(Vector3(7.0f, 2.0f, 2.0f), 1.9f));
+	// Near a corner, but not touching it (distance is sqrt(3))
+	assert(!aabb.IntersectsSphere(Vector3(6.0f, 6.0f, 6.0f), 1.7f));
+	assert(aabb.IntersectsSphere(Vector3(6.0f, 6.0f, 6.0f), 1.8f));
+}
+
+void TestAABB::TestContains()
+{
+	AABB aabb1{ Vector3(0.0f, 0.0f, 0.0f), Vector3(5.0f, 5.0f, 5.0f) };
+	AABB aabb2{ Vector3(1.0f, 1.0f, 1.0f), Vector3(5.0f, 4.0f, 3.0f) };
+	AABB aabb3{ Vector3(4.0f, 4.0f, 4.0f), Vector3(6.0f, 5.0f, 5.0f) };
+
+	assert(aabb1.Contains(aabb1));
+	assert(aabb1.Contains(aabb2));
+	assert(!aabb2.Contains(aabb1));
+	// Intersecting isn't enough
+	assert(!aabb1.Contains(aabb3));
+}
+
+void TestAABB::TestMerge()
+{
+	AABB aabb1{ Vector3(0.0f, 0.0f, 0.0f), Vector3(5.0f, 5.0f, 5.0f) };
+	AABB aabb2{ Vector3(-1.0f, 2.0f, 3.0f), Vector3(4.0f, 8.0f, 9.0f) };
+
+	aabb1.Merge(aabb2);
+	assert(aabb1.minCoords == Vector3(-1.0f, 0.0f, 0.0f));
+	assert(aabb1.maxCoords == Vector3(5.0f, 8.0f, 9.0f));
+	assert(aabb1.Contains(aabb2));
+}
+
+void TestAABB::TestGetPenetration()
+{
+	AABB aabb1{ Vector3(0.0f, 0.0f, 0.0f), Vector3(5.0f, 5.0f, 5.0f) };
+	AABB aabb2{ Vector3(6.0f, 7.0f, 8.0f), Vector3(10.0f, 10.0f, 10.0f) };
+	AABB aabb3{ Vector3(4.0f, 1.0f, 1.0f), Vector3(8.0f, 4.0f, 4.0f) };
+
+	Vector3 normal;
+	float depth = 0.0f;
+	assert(!aabb1.GetPenetration(aabb2, normal, depth));
+
+	// Minimum intersection is along X, and aabb1 lies on the left
+	assert(aabb1.GetPenetration(aabb3, normal, depth));
+	assert(depth == 1.0f);
+	assert(normal == Vector3(-1.0f, 0.0f, 0.0f));
+
+	assert(aabb3.GetPenetration(aabb1, normal, depth));
+	assert(normal == Vector3(1.0f, 0.0f, 0.0f));
+}
+
 void TestAABB::TestToString()
 {
 	AABB aabb1{ Vector3(1.0f, 2.0f, -1.0f), Vector3(5.0f, 5.0f, 5.0f) };
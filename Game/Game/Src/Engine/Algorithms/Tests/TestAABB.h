@@ -12,6 +12,10 @@ public:
 	static void RunTests();
 
 	static void TestIntersects();
+	static void TestIntersectsSphere();
+	static void TestContains();
+	static void TestMerge();
+	static void TestGetPenetration();
 	static void TestToString();
 };
 
@@ -33,7 +33,12 @@ void TestBVH::RunTests()
 
 	TestBuildTree(bvhTree, boxColliders);
 	TestCheckCollisions(bvhTree);
+	TestCopyTree(bvhTree);
+	TestQueryOverlaps(bvhTree, boxColliders);
 	TestDestroy(bvhTree);
+	TestBuildTreeFromItems(boxColliders);
+	TestDropRemovedColliders(boxColliders);
+	TestCheckCollisionsSkipsRemoved();
 	Logger::Get().Log("[UNITTEST] BVH - All tests passed!");
 
 	// Don't forget to free up the memory :)
@@ -57,9 +62,143 @@ void TestBVH::TestCheckCollisions(BVH* bvhTree)
 	assert(bvhTree->CheckCollisions(boxC));
 }
 
+void TestBVH::TestCopyTree(BVH* bvhTree)
+{
+	BVH copy;
+	copy.CopyTree(*bvhTree);
+	assert(copy.root != nullptr && copy.root != bvhTree->root);
+
+	// Copy must find the same colliders
+	AABB region(Vector3(20.0f, 20.0f, 20.0f), Vector3(60.0f, 60.0f, 60.0f));
+	std::vector<BoxCollider*> original, copied;
+	bvhTree->QueryOverlaps(region, original);
+	copy.QueryOverlaps(region, copied);
+	std::sort(original.begin(), original.end());
+	std::sort(copied.begin(), copied.end());
+	assert(original == copied);
+
+	copy.Destroy();
+	assert(copy.root == nullptr);
+}
+
+void TestBVH::TestQueryOverlaps(BVH* bvhTree, std::vector<BoxCollider*>& boxColliders)
+{
+	// All the sample boxes are inside [0, 110]
+	std::vector<BoxCollider*> result;
+	bvhTree->QuerySphereOverlaps(Vector3(55.0f, 55.0f, 55.0f), 100.0f, result);
+	assert(result.size() == boxColliders.size());
+
+	result.clear();
+	bvhTree->QuerySphereOverlaps(Vector3(500.0f, 500.0f, 500.0f), 100.0f, result);
+	assert(result.empty());
+
+	// Sample boxes are GENERIC
+	AABB everything(Vector3(-1.0f, -1.0f, -1.0f), Vector3(200.0f, 200.0f, 200.0f));
+	bvhTree->QueryOverlaps(everything, result, false, ColliderTagBit(BALL) | ColliderTagBit(PLAYER));
+	assert(result.empty());
+	bvhTree->QueryOverlaps(everything, result, false, ColliderTagBit(GENERIC));
+	assert(result.size() == boxColliders.size());
+}
+
+void TestBVH::TestBuildTreeFromItems(std::vector<BoxCollider*>& boxColliders)
+{
+	// Boxes copied at some point. Colliders have moved since.
+	std::vector<BVHBuildItem> items(boxColliders.size());
+	for (size_t i = 0; i < boxColliders.size(); i++)
+	{
+		items[i].boundingBox = boxColliders[i]->boundingBox;
+		items[i].boundingBox.minCoords += 1000.0f;
+		items[i].boundingBox.maxCoords += 1000.0f;
+		items[i].collider = boxColliders[i];
+	}
+
+	// Tree must be built from the copies only
+	BVH bvhTree;
+	bvhTree.BuildTree(items);
+	assert(bvhTree.root->boundingBox.minCoords.x >= 1000.0f);
+	for (BoxCollider* boxC : boxColliders)
+		assert(!bvhTree.root->boundingBox.Intersects(boxC->boundingBox));
+
+	bvhTree.Destroy();
+}
+
+void TestBVH::TestDropRemovedColliders(std::vector<BoxCollider*>& boxColliders)
+{
+	DenseRegistry<Collider*> registry;
+	std::vector<RegistryHandle> handles(boxColliders.size());
+	std::vector<BVHBuildItem> items(boxColliders.size());
+	for (size_t i = 0; i < boxColliders.size(); i++)
+	{
+		handles[i] = registry.Add(boxColliders[i]);
+		items[i].boundingBox = boxColliders[i]->boundingBox;
+		items[i].collider = boxColliders[i];
+		items[i].handle = handles[i];
+	}
+
+	BVH bvhTree;
+	bvhTree.BuildTree(items);
+	assert(bvhTree.DropRemovedColliders(registry) == 0);
+
+	// Remove every other collider. A new one reusing a slot must not bring the old handle back.
+	for (size_t i = 0; i < handles.size(); i += 2)
+		registry.Remove(handles[i]);
+	registry.Add(boxColliders[0]);
+	assert(bvhTree.DropRemovedColliders(registry) == (boxColliders.size() + 1) / 2);
+
+	bvhTree.RebuildTree();
+	std::vector<BoxCollider*> result;
+	bvhTree.QueryOverlaps(AABB(Vector3(-1.0f, -1.0f, -1.0f), Vector3(200.0f, 200.0f, 200.0f)), result, false, ALL_COLLIDER_TAGS);
+	assert(result.size() == boxColliders.size() / 2);
+	for (BoxCollider* boxC : result)
+	{
+		size_t index = std::find(boxColliders.begin(), boxColliders.end(), boxC) - boxColliders.begin();
+		assert(index % 2 == 1);
+	}
+
+	bvhTree.Destroy();
+}
+
 void TestBVH::TestDestroy(BVH* bvhTree)
 {
 	assert(bvhTree->root != nullptr);
 	bvhTree->Destroy();
 	assert(bvhTree->root == nullptr);
 }
+
+void TestBVH::TestCheckCollisionsSkipsRemoved()
+{
+	BoxCollider* removed = new BoxCollider();
+	removed->boundingBox = AABB(Vector3(0.0f, 0.0f, 0.0f), Vector3(10.0f, 10.0f, 10.0f));
+	BoxCollider* kept = new BoxCollider();
+	kept->boundingBox = AABB(Vector3(50.0f, 0.0f, 0.0f), Vector3(60.0f, 10.0f, 10.0f));
+	BoxCollider* probe = new BoxCollider();
+	probe->boundingBox = AABB(Vector3(5.0f, 5.0f, 5.0f), Vector3(55.0f, 15.0f, 15.0f));
+
+	DenseRegistry<Collider*> registry;
+	std::vector<BVHBuildItem> items(2);
+	items[0].boundingBox = removed->boundingBox;
+	items[0].collider = removed;
+	items[0].handle = registry.Add(removed);
+	items[1].boundingBox = kept->boundingBox;
+	items[1].collider = kept;
+	items[1].handle = registry.Add(kept);
+	RegistryHandle removedHandle = items[0].handle;
+
+	BVH bvhTree;
+	bvhTree.BuildTree(items);
+	Vector3 normal;
+	assert(bvhTree.CheckCollisions(probe, normal, GENERIC, &registry) != nullptr);
+
+	// Still in the tree till the next refit, but skipped. The one behind it is found instead.
+	registry.Remove(removedHandle);
+	assert(bvhTree.CheckCollisions(probe, normal, GENERIC, &registry) == kept);
+	kept->boundingBox = AABB(Vector3(80.0f, 0.0f, 0.0f), Vector3(90.0f, 10.0f, 10.0f));
+	assert(bvhTree.CheckCollisions(probe, normal, GENERIC, &registry) == nullptr);
+	// Without the registry it is still there
+	assert(bvhTree.CheckCollisions(probe, normal) == removed);
+
+	bvhTree.Destroy();
+	delete removed;
+	delete kept;
+	delete probe;
+}
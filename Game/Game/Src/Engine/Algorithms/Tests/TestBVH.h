@@ -14,6 +14,11 @@ class TestBVH
 	static void TestBuildTree(BVH*, std::vector<BoxCollider*>&);
 	static void TestDestroy(BVH*);
 	static void TestCheckCollisions(BVH*);
+	static void TestCopyTree(BVH*);
+	static void TestQueryOverlaps(BVH*, std::vector<BoxCollider*>&);
+	static void TestBuildTreeFromItems(std::vector<BoxCollider*>&);
+	static void TestDropRemovedColliders(std::vector<BoxCollider*>&);
+	static void TestCheckCollisionsSkipsRemoved();
 
 public:
 	static void RunTests();
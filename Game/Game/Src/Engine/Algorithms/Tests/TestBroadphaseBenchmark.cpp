@@ -0,0 +1,120 @@
+// @file: TestBroadphaseBenchmark.cpp
+//
+// @brief: Cpp file for TestBroadphaseBenchmark class containing unit tests for BroadphaseBenchmark class.
+
+#include "stdafx.h"
+#include "TestBroadphaseBenchmark.h"
+#include "Engine/Algorithms/BroadphaseBenchmark.h"
+#include "Engine/Algorithms/BroadphaseRecording.h"
+#include "Engine/Core/Logger.h"
+#include "Engine/Math/Random.h"
+
+void TestBroadphaseBenchmark::RunTests()
+{
+	// Sample recording: random boxes drifting along Z, plus a floor under all of them
+	BroadphaseRecording recording;
+	std::vector<RecordedBox> frame;
+	for (unsigned int i = 0; i < 30; i++)
+	{
+		RecordedBox box;
+		box.id = i;
+		Vector3 minC{ Random::Get().Float() * 50.0f, Random::Get().Float() * 50.0f, Random::Get().Float() * 50.0f };
+		Vector3 maxC{ minC.x + Random::Get().Float() * 10.0f,
+					  minC.y + Random::Get().Float() * 10.0f,
+					  minC.z + Random::Get().Float() * 10.0f };
+		box.boundingBox = AABB(minC, maxC);
+		frame.push_back(box);
+	}
+	RecordedBox floor;
+	floor.id = 30;
+	floor.boundingBox = AABB(Vector3(-100.0f, -1.0f, -100.0f), Vector3(200.0f, 1.0f, 200.0f));
+	frame.push_back(floor);
+
+	for (size_t f = 0; f < 4; f++)
+	{
+		for (RecordedBox& box : frame)
+		{
+			box.boundingBox.minCoords.z += 2.0f;
+			box.boundingBox.maxCoords.z += 2.0f;
+		}
+		// Collider removed in the last frame
+		if (f == 3)
+			frame.erase(frame.begin());
+		recording.AddFrame(frame);
+	}
+
+	TestRecording(recording);
+	TestFileRoundTrip(recording);
+	TestRun(recording);
+	Logger::Get().Log("[UNITTEST] BroadphaseBenchmark - All tests passed!");
+}
+
+void TestBroadphaseBenchmark::TestRecording(BroadphaseRecording& recording)
+{
+	assert(recording.GetFrameCount() == 4);
+	assert(recording.GetBoxCount(0) == 31);
+	assert(recording.GetBoxCount(3) == 30);
+	assert(recording.GetFrame(3)[0].id == 1);
+}
+
+void TestBroadphaseBenchmark::TestFileRoundTrip(BroadphaseRecording& recording)
+{
+	const std::string filename = "TestBroadphaseRecording.bprc";
+	std::ofstream file(filename, std::ios::binary);
+	assert(file.is_open());
+	BroadphaseRecording::WriteHeader(file);
+	std::vector<RecordedBox> frame;
+	for (size_t f = 0; f < recording.GetFrameCount(); f++)
+	{
+		frame.assign(recording.GetFrame(f), recording.GetFrame(f) + recording.GetBoxCount(f));
+		BroadphaseRecording::WriteFrame(file, frame);
+	}
+	// Game closed while writing a frame
+	unsigned int cutOffCount = 5;
+	file.write(reinterpret_cast<const char*>(&cutOffCount), sizeof(cutOffCount));
+	file.close();
+
+	BroadphaseRecording loaded;
+	assert(loaded.Load(filename));
+	assert(loaded.GetFrameCount() == recording.GetFrameCount());
+	for (size_t f = 0; f < recording.GetFrameCount(); f++)
+	{
+		assert(loaded.GetBoxCount(f) == recording.GetBoxCount(f));
+		for (size_t i = 0; i < recording.GetBoxCount(f); i++)
+		{
+			const RecordedBox& expected = recording.GetFrame(f)[i];
+			RecordedBox actual = loaded.GetFrame(f)[i];
+			assert(actual.id == expected.id);
+			assert(actual.boundingBox.minCoords == expected.boundingBox.minCoords);
+			assert(actual.boundingBox.maxCoords == expected.boundingBox.maxCoords);
+		}
+	}
+	std::remove(filename.c_str());
+}
+
+void TestBroadphaseBenchmark::TestRun(BroadphaseRecording& recording)
+{
+	BroadphaseBenchmark benchmark;
+	assert(benchmark.Run(recording));
+	assert(benchmark.GetBroadphaseCount() > 1);
+
+	for (size_t frame = 0; frame < recording.GetFrameCount(); frame++)
+	{
+		// Brute force pair count
+		const RecordedBox* boxes = recording.GetFrame(frame);
+		size_t count = recording.GetBoxCount(frame);
+		size_t pairs = 0;
+		for (size_t i = 0; i < count; i++)
+			for (size_t j = i + 1; j < count; j++)
+				if (boxes[i].boundingBox.Intersects(boxes[j].boundingBox))
+					++pairs;
+
+		for (size_t b = 0; b < benchmark.GetBroadphaseCount(); b++)
+		{
+			const BroadphaseFrameResult& result = benchmark.GetResults(b)[frame];
+			assert(result.pairs == pairs);
+			// Built on the first frame & when a collider got removed, updated otherwise
+			assert(result.isBuild == (frame == 0 || frame == 3));
+		}
+	}
+}
@@ -0,0 +1,21 @@
+// @file: TestBroadphaseBenchmark.h
+//
+// @brief: Header file for TestBroadphaseBenchmark class containing unit tests for BroadphaseBenchmark class.
+
+#pragma once
+#ifndef _TEST_BROADPHASE_BENCHMARK_H_
+#define _TEST_BROADPHASE_BENCHMARK_H_
+
+class BroadphaseRecording;
+
+class TestBroadphaseBenchmark
+{
+	static void TestRecording(BroadphaseRecording&);
+	static void TestFileRoundTrip(BroadphaseRecording&);
+	static void TestRun(BroadphaseRecording&);
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_BROADPHASE_BENCHMARK_H_
@@ -0,0 +1,112 @@
+// @file: TestQuantizedBVH.cpp
+//
+// @brief: Cpp file for TestQuantizedBVH class containing unit tests for QuantizedBVH class.
+
+#include "stdafx.h"
+#include "TestQuantizedBVH.h"
+#include "Engine/Algorithms/QuantizedBVH.h"
+#include "Engine/Algorithms/BVH.h"
+#include "Engine/Algorithms/AABB.h"
+#include "Engine/Core/Logger.h"
+#include "Engine/Components/BoxCollider.h"
+#include "Engine/Math/Random.h"
+
+void TestQuantizedBVH::RunTests()
+{
+	BVH* bvhTree = new BVH();
+	QuantizedBVH* quantizedTree = new QuantizedBVH();
+
+	// Sample box colliders, spread far apart so that small boxes need many quantization steps
+	std::vector<BoxCollider*> boxColliders;
+	for (size_t i = 0; i < 200; i++)
+	{
+		BoxCollider* boxC = new BoxCollider();
+
+		Vector3 minC{ Random::Get().Float() * 1000.0f,
+					Random::Get().Float() * 100.0f,
+					Random::Get().Float() * 1000.0f };
+		Vector3 maxC{ minC.x + Random::Get().Float() * 5.0f,
+					minC.y + Random::Get().Float() * 5.0f,
+					minC.z + Random::Get().Float() * 5.0f };
+		boxC->boundingBox = AABB(minC, maxC);
+
+		boxColliders.push_back(boxC);
+	}
+	bvhTree->BuildTree(boxColliders);
+
+	TestBuild(bvhTree, quantizedTree);
+	TestQuantize();
+	TestQueryOverlaps(bvhTree, quantizedTree, boxColliders);
+	Logger::Get().Log("[UNITTEST] QuantizedBVH - All tests passed!");
+
+	bvhTree->Destroy();
+	delete bvhTree;
+	delete quantizedTree;
+	for (BoxCollider* boxC : boxColliders)
+	{
+		delete boxC;
+	}
+}
+
+void TestQuantizedBVH::TestBuild(BVH* bvhTree, QuantizedBVH* quantizedTree)
+{
+	assert(quantizedTree->rootRef == QuantizedBVH::EMPTY_CHILD);
+	quantizedTree->Build(*bvhTree);
+	assert(quantizedTree->rootRef != QuantizedBVH::EMPTY_CHILD);
+	assert(quantizedTree->GetNodeCount() > 0);
+	assert(quantizedTree->leafColliders.size() == 200);
+	// Should take well under the memory of the original tree
+	assert(quantizedTree->GetMemoryUsage() * 2 <= bvhTree->GetMemoryUsage());
+}
+
+void TestQuantizedBVH::TestQuantize()
+{
+	AABB parent{ Vector3(-10.0f, 0.0f, 3.0f), Vector3(90.0f, 0.0f, 1003.0f) };
+	AABB child{ Vector3(12.3456f, 0.0f, 500.001f), Vector3(12.3457f, 0.0f, 500.002f) };
+	unsigned short qMin[3], qMax[3];
+	AABB quantized = QuantizedBVH::Quantize(child, parent, qMin, qMax);
+
+	// Rounded outwards
+	assert(quantized.Contains(child));
+	assert(parent.Contains(quantized));
+	// But not by more than a step
+	assert(quantized.maxCoords.x - quantized.minCoords.x <= 2.0f * 100.0f / 65535.0f + 0.0001f);
+
+	// Child covering the whole parent stays exactly the same
+	quantized = QuantizedBVH::Quantize(parent, parent, qMin, qMax);
+	assert(quantized.Contains(parent) && parent.Contains(quantized));
+}
+
+void TestQuantizedBVH::TestQueryOverlaps(BVH* bvhTree, QuantizedBVH* quantizedTree, std::vector<BoxCollider*>& boxColliders)
+{
+	// Rounding must never lose a collider: each one must find itself
+	std::vector<BoxCollider*> result;
+	for (BoxCollider* boxC : boxColliders)
+	{
+		result.clear();
+		quantizedTree->QueryOverlaps(boxC->boundingBox, result);
+		assert(std::find(result.begin(), result.end(), boxC) != result.end());
+	}
+
+	// Same results as the original tree
+	for (size_t i = 0; i < 20; i++)
+	{
+		Vector3 center{ Random::Get().Float() * 1000.0f, Random::Get().Float() * 100.0f, Random::Get().Float() * 1000.0f };
+		AABB region(center - Vector3(50.0f, 50.0f, 50.0f), center + Vector3(50.0f, 50.0f, 50.0f));
+
+		std::vector<BoxCollider*> original, quantized;
+		bvhTree->QueryOverlaps(region, original);
+		quantizedTree->QueryOverlaps(region, quantized);
+		std::sort(original.begin(), original.end());
+		std::sort(quantized.begin(), quantized.end());
+		assert(original == quantized);
+
+		original.clear();
+		quantized.clear();
+		bvhTree->QuerySphereOverlaps(center, 50.0f, original);
+		quantizedTree->QuerySphereOverlaps(center, 50.0f, quantized);
+		std::sort(original.begin(), original.end());
+		std::sort(quantized.begin(), quantized.end());
+		assert(original == quantized);
+	}
+}
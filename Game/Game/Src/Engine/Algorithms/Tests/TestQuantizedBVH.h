@@ -0,0 +1,23 @@
+// @file: TestQuantizedBVH.h
+//
+// @brief: Header file for TestQuantizedBVH class containing unit tests for QuantizedBVH class.
+
+#pragma once
+#ifndef _TEST_QUANTIZED_BVH_H_
+#define _TEST_QUANTIZED_BVH_H_
+
+class BVH;
+class QuantizedBVH;
+class BoxCollider;
+
+class TestQuantizedBVH
+{
+	static void TestBuild(BVH*, QuantizedBVH*);
+	static void TestQuantize();
+	static void TestQueryOverlaps(BVH*, QuantizedBVH*, std::vector<BoxCollider*>&);
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_QUANTIZED_BVH_H_
@@ -26,6 +26,9 @@ void BoxCollider::Initialize()
 	{
 		meshR = static_cast<MeshRenderer*>(entity->GetComponent(MeshRendererC));
 	}
+
+	// Mesh might have changed (entities get reused from the pool)
+	isCallibrated = false;
 }
 
 void BoxCollider::Update(float deltaTime)
@@ -43,10 +46,19 @@ void BoxCollider::Callibrate()
 		return;
 	}
 
-	const Mesh mesh = meshR->GetMesh();
+	Transform& transform = GetEntity()->GetTransform();
+	if (isCallibrated && transform.position == lastPosition && transform.rotation == lastRotation && transform.scale == lastScale)
+		return;
+
+	const Mesh& mesh = meshR->GetMesh();
 	if (mesh.faces.size() == 0)
 		return;
 
+	isCallibrated = true;
+	lastPosition = transform.position;
+	lastRotation = transform.rotation;
+	lastScale = transform.scale;
+
 	Matrix4x4 mWorld = meshR->GetWorldMatrix();
 
 	Vector3 minC(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
@@ -78,6 +90,20 @@ void BoxCollider::Callibrate()
 	}
 }
 
+void BoxCollider::Translate(const Vector3& delta)
+{
+	if (!isCallibrated)
+	{
+		Callibrate();
+		return;
+	}
+
+	boundingBox.minCoords += delta;
+	boundingBox.maxCoords += delta;
+	lastPosition = GetEntity()->GetTransform().position;
+	gotUpdated = true;
+}
+
 void BoxCollider::Render()
 {
 	if (!shouldRender)
@@ -22,11 +22,28 @@ private:
 	// Caching mesh renderer of the entity
 	MeshRenderer* meshR = nullptr;
 
+	// Transform used in the last callibration. Box doesn't need to be
+	// reconstructed till the transform changes (for example, resting bodies).
+	bool isCallibrated = false;
+	Vector3 lastPosition;
+	Vector3 lastRotation;
+	Vector3 lastScale;
+
+	// Has the box moved outside the regular update since the active BVH tree was built?
+	// BVH nodes above it may not cover it till the next BVH update.
+	bool movedSinceBVHUpdate = false;
+
 	/**
 	 * @brief Construct the box collider using the mesh renderer of this entity
 	 */
 	void Callibrate() override;
 
+	/**
+	 * @brief Move the box along with the entity without going through the mesh again.
+	 * Only valid if the entity was just translated by the same delta.
+	 */
+	void Translate(const Vector3& delta);
+
 public:
 	// The actual collider is stored as an AABB
 	AABB boundingBox;
@@ -47,6 +64,9 @@ public:
 	void Destroy() override { }
 
 	bool DidCollide(Collider* collider) override;
+
+	friend class CollisionSystem;
+	friend class PhysicsSystem;
 };
 
 #endif // !_BOX_COLLIDER_H_
@@ -5,6 +5,7 @@
 
 #include "stdafx.h"
 #include "Engine/Components/Collider.h"
+#include "Engine/Systems/CollisionSystem.h"
 
 void Collider::OnCollisionEnter(Collider* other)
 {
@@ -13,3 +14,12 @@ void Collider::OnCollisionEnter(Collider* other)
 		OnCollisionEnterFunc(other);
 	}
 }
+
+void Collider::SetActivatesTriggers(bool value)
+{
+	if (activatesTriggers == value)
+		return;
+
+	activatesTriggers = value;
+	CollisionSystem::Get().UpdateTriggerActivator(this);
+}
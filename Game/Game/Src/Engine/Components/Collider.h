@@ -13,15 +13,22 @@
 enum ColliderTag {
 	GENERIC,  // collides with all
 	BALL,
-	BREAKABLE
+	BREAKABLE,
+	PLAYER
 };
 
+// Set of collider tags, used to filter queries. Build it with ColliderTagBit.
+using ColliderTagMask = unsigned int;
+const ColliderTagMask ALL_COLLIDER_TAGS = 0xFFFFFFFF;
+inline ColliderTagMask ColliderTagBit(ColliderTag tag) { return 1u << tag; }
+
 enum ColliderType {
 	BOX,
 	SPHERE  // NOT IMPLEMENTED
 };
 
 class Vector3;
+class RigidBody;
 
 class Collider : public Renderable
 {
@@ -33,10 +40,21 @@ class Collider : public Renderable
 protected:
 	ColliderTag colliderTag = GENERIC;
 	bool shouldRender = false;
+	// Triggers are not solid. They only report what overlaps them.
+	bool isTrigger = false;
+	// Can this collider set off triggers?
+	bool activatesTriggers = false;
 
 	// A flag for collision system to check if the collider got updated by any component
 	bool gotUpdated = false;
 
+	// Handles of the collider in CollisionSystem
+	RegistryHandle collisionHandle = INVALID_REGISTRY_HANDLE;
+	RegistryHandle activatorHandle = INVALID_REGISTRY_HANDLE;
+
+	// Rigid body of the entity (if any). Set by the rigid body itself.
+	RigidBody* rigidBody = nullptr;
+
 	// Called in OnCollisionEnter
 	OnCollisionCallback OnCollisionEnterFunc = nullptr;
 
@@ -53,13 +71,22 @@ public:
 
 	/**
 	 * @brief Gets called by Entity::Move() when collision happens.
+	 * Physics calls it once when two colliders start touching, not on every frame of the contact.
 	 */
 	void OnCollisionEnter(Collider* other);
 	void SetOnCollisionEnterCallback(OnCollisionCallback callback) { OnCollisionEnterFunc = callback; }
 
 	void SetColliderTag(ColliderTag tag) { colliderTag = tag; }
 	ColliderTag GetColliderTag() const { return colliderTag; }
+	RigidBody* GetRigidBody() const { return rigidBody; }
 	void SetShouldRender(bool value) { shouldRender = value; }
+	bool IsTrigger() const { return isTrigger; }
+	/**
+	 * @brief Make this collider set off the triggers it overlaps.
+	 * Keep it to the few colliders that need it (like the player), as each one costs a broadphase query per frame.
+	 */
+	void SetActivatesTriggers(bool value);
+	bool ActivatesTriggers() const { return activatesTriggers; }
 	bool ShouldRender() const { return shouldRender; }
 
 	void Update(float) override { }
@@ -67,7 +94,9 @@ public:
 
 	friend class CollisionSystem;
 	friend class PhysicsSystem;
+	friend class BVH;
 	friend class Entity;
+	friend class RigidBody;
 };
 
 #endif // !_COLLIDER_H_
@@ -5,8 +5,23 @@
 #include "stdafx.h"
 #include "Engine/Components/Component.h"
 #include "Engine/Components/Entity.h"
+#include "Engine/Pools/ComponentAllocator.h"
 
 void Component::ChangeEntity(Entity* _entity)
 {
     entity = _entity;
 }
+
+void Component::Free(Component* component)
+{
+    // Memory of a chunk component belongs to the chunk
+    if (component->isChunkAllocated)
+    {
+        component->~Component();
+        return;
+    }
+
+    ComponentType componentType = component->type;
+    component->~Component();
+    ComponentAllocator::Get().Free(componentType, component);
+}
@@ -19,6 +19,7 @@ enum ComponentType {
     MeshRendererC,
     SpriteC,
     BoxColliderC,
+    TriggerColliderC,
     RigidBodyC,
     ParticlesC,
     CanvasC,
@@ -30,20 +31,43 @@ enum ComponentType {
     LevelGeneratorC,
     UIManagerC,
     DoorOpenerC,
-    StarsControllerC
+    StarsControllerC,
+    // Number of component types. Must stay last.
+    COMPONENT_TYPE_COUNT
 };
 
+// Set of component types, used for archetype checks. Build it with ComponentTypeBit.
+using ComponentMask = unsigned int;
+static_assert(COMPONENT_TYPE_COUNT <= 32, "ComponentMask can't hold all component types");
+inline ComponentMask ComponentTypeBit(ComponentType type) { return 1u << type; }
+
 class Component : public Object
 {
 protected:
     Entity* entity = nullptr;
     ComponentType type = UNDEFINEDC;
+    // Lives in an archetype chunk of its entity pool, so it must only be destroyed in place.
+    // Otherwise its memory comes from the ComponentAllocator.
+    bool isChunkAllocated = false;
+    // Updated by an engine system (see Scene::UpdateComponentsInParallel) instead of by its entity
+    bool isUpdatedBySystem = false;
+    // Update only touches the component & its own entity, so the scene updates the components of this type on
+    // all cores at once. Structural changes (creating or removing entities...) must go through Scene::Defer.
+    bool isParallelSafe = false;
 
 public:
     virtual void Update(float) = 0;
 
+    /**
+     * @brief Free a component, whether it was created in the ComponentAllocator or in an archetype chunk.
+     */
+    static void Free(Component*);
+
     void ChangeEntity(Entity*);
     Entity* GetEntity() const { return entity; };
+    ComponentType GetType() const { return type; }
+    bool IsUpdatedBySystem() const { return isUpdatedBySystem; }
+    bool IsParallelSafe() const { return isParallelSafe; }
 
     friend class Entity;
     friend class EntityPool;
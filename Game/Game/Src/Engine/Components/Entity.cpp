@@ -5,6 +5,7 @@
 #include "stdafx.h"
 #include "App/app.h"
 #include "Engine/Systems/SceneManager.h"
+#include "Engine/Systems/Scene.h"
 #include "Engine/Systems/CollisionSystem.h"
 #include "Engine/Components/Entity.h"
 #include "Engine/Components/Component.h"
@@ -51,7 +52,8 @@ void Entity::Update(float deltaTime)
 {
 	for (Component* component : components)
 	{
-		if (component->IsActive())
+		// Parallel-safe components are updated by the scene, per type (see Scene::Update)
+		if (component->IsActive() && !component->isUpdatedBySystem && !component->isParallelSafe)
 		{
 			component->Update(deltaTime);
 		}
@@ -63,7 +65,8 @@ void Entity::PostUpdate()
 	for (Component* component : componentsToRemove)
 	{
 		components.remove(component);
-		delete component;
+		UntrackComponent(component);
+		Component::Free(component);
 	}
 	componentsToRemove.clear();
 }
@@ -73,35 +76,80 @@ void Entity::Destroy()
 	for (Component* component : components)
 	{
 		component->Destroy();
-		delete component;
+		Component::Free(component);
 	}
 	components.clear();
+	// Components of entities never taken from their pool are still here. They were never initialized.
+	for (Component* component : componentsToAdd)
+	{
+		Component::Free(component);
+	}
+	componentsToAdd.clear();
+
+	std::fill(std::begin(componentSlots), std::end(componentSlots), nullptr);
+	componentMask = 0;
 }
 
-bool Entity::HasComponent(ComponentType componentType)
+void Entity::TrackComponent(Component* component)
 {
-	for (Component* component : components)
+	componentsToAdd.push_back(component);
+
+	if (componentSlots[component->type] == nullptr)
+		componentSlots[component->type] = component;
+	if (componentMask & ComponentTypeBit(component->type))
+		return;
+
+	componentMask |= ComponentTypeBit(component->type);
+	if (scene != nullptr)
+		scene->AddToComponentView(this, component->type);
+}
+
+void Entity::UntrackComponent(Component* component)
+{
+	if (componentSlots[component->type] != component)
+		return;
+
+	// Another component of the same type takes the slot, if there is one
+	componentSlots[component->type] = nullptr;
+	for (Component* other : components)
 	{
-		if (component->type == componentType)
+		if (other->type == component->type && other != component)
 		{
-			return true;
+			componentSlots[component->type] = other;
+			return;
 		}
 	}
-	// In case this runs before PreUpdate, check in componentsToAdd
-	for (Component* component : componentsToAdd)
+	for (Component* other : componentsToAdd)
 	{
-		if (component->type == componentType)
+		if (other->type == component->type && other != component)
 		{
-			return true;
+			componentSlots[component->type] = other;
+			return;
 		}
 	}
-	return false;
+	componentMask &= ~ComponentTypeBit(component->type);
+	if (scene != nullptr)
+		scene->RemoveFromComponentView(this, component->type);
 }
 
-bool Entity::HasRenderable()
+void Entity::SetName(const std::string& n)
+{
+	// The scene indexes entities by name
+	if (scene != nullptr)
+		scene->RenameEntity(this, n);
+	else
+		name = n;
+}
+
+bool Entity::HasComponent(ComponentType componentType) const
+{
+	return (componentMask & ComponentTypeBit(componentType)) != 0;
+}
+
+bool Entity::HasRenderable() const
 {
 	// TODO: Find a way to avoid this hard-coding
-	return (HasComponent(SpriteC) || HasComponent(MeshRendererC));
+	return (componentMask & (ComponentTypeBit(SpriteC) | ComponentTypeBit(MeshRendererC))) != 0;
 }
 
 Component* const Entity::GetComponent(STRCODE componentUId)
@@ -126,22 +174,9 @@ Component* const Entity::GetComponent(STRCODE componentUId)
 
 Component* const Entity::GetComponent(ComponentType componentType)
 {
-	for (Component* component : components)
-	{
-		if (component->type == componentType)
-		{
-			return component;
-		}
-	}
-	// If this ran before preUpdate, component would be in componentsToAdd
-	for (Component* component : componentsToAdd)
-	{
-		if (component->type == componentType)
-		{
-			return component;
-		}
-	}
-	return nullptr;
+	if (componentType <= UNDEFINEDC || componentType >= COMPONENT_TYPE_COUNT)
+		return nullptr;
+	return componentSlots[componentType];
 }
 
 bool Entity::RemoveComponent(ComponentType componentType)
@@ -9,10 +9,26 @@
 
 #include "Engine/Core/Object.h"
 #include "Engine/Components/Transform.h"
+#include "Engine/Core/DenseRegistry.h"
 
 class Component;
 class Collider;
 class EntityPool;
+class Scene;
+
+/**
+ * Handle of an entity in its scene (32 bits, slot index & generation).
+ * It goes stale as soon as the entity is removed, even if its pool hands the same entity out again,
+ * so holding a handle is safer than holding an Entity pointer across frames. See Scene::GetEntity.
+ */
+struct EntityHandle
+{
+	RegistryHandle value = INVALID_REGISTRY_HANDLE;
+
+	bool IsNull() const { return value == INVALID_REGISTRY_HANDLE; }
+	bool operator==(const EntityHandle& other) const { return value == other.value; }
+	bool operator!=(const EntityHandle& other) const { return value != other.value; }
+};
 
 class Entity final : public Object
 {
@@ -21,13 +37,36 @@ private:
 	Transform transform;
 	// Each entity must know about its source pool to return back to it
 	EntityPool* sourcePool = nullptr;
+	// Row of the entity in the archetype storage of its pool
+	size_t poolRow = 0;
 
 	std::string name = "";
+	// Scene tracking the entity & its handle there. Null & invalid once the entity gets removed.
+	Scene* scene = nullptr;
+	EntityHandle sceneHandle;
 
 	std::list<Component*> components;
 	std::list<Component*> componentsToAdd;
 	std::list<Component*> componentsToRemove;
 
+	// Component of each type (the first one, if there are more), so that lookups don't search the lists.
+	// Covers componentsToAdd too.
+	Component* componentSlots[COMPONENT_TYPE_COUNT] = {};
+	// Bits of all the component types the entity has
+	ComponentMask componentMask = 0;
+	// Handle in the scene's view of each component type the entity has (see Scene::FindEntityWithComponent).
+	// Only the ones in componentMask are meaningful.
+	RegistryHandle componentViewHandles[COMPONENT_TYPE_COUNT] = {};
+
+	/**
+	 * @brief Add a new component. It gets updated from the next PreUpdate, but can be looked up right away.
+	 */
+	void TrackComponent(Component* component);
+	/**
+	 * @brief Forget a component which is being removed.
+	 */
+	void UntrackComponent(Component* component);
+
 protected:
 	Entity();
 	Entity(std::string _guid);
@@ -41,8 +80,13 @@ protected:
 public:
 	void Initialize() override;
 
-	bool HasComponent(ComponentType);
-	bool HasRenderable();
+	bool HasComponent(ComponentType) const;
+	/**
+	 * @brief Check if the entity has all the component types of a mask (built with ComponentTypeBit).
+	 */
+	bool HasComponents(ComponentMask mask) const { return (componentMask & mask) == mask; }
+	ComponentMask GetComponentMask() const { return componentMask; }
+	bool HasRenderable() const;
 	Component* const GetComponent(STRCODE componentUId);
 	Component* const GetComponent(ComponentType);
 
@@ -65,12 +109,17 @@ public:
 	// Rotate an entity in cartesian system along Z, after checking collision
 	void CartesianRotationZ(Vector3& rotateDir, Collider* collider, float rotationSpeed);
 
+	/**
+	 * @brief Get the handle of the entity in its scene. Null if it isn't in a scene.
+	 */
+	EntityHandle GetHandle() const { return sceneHandle; }
 	Transform& GetTransform() { return transform; }
 	const std::string& GetName() const { return name; }
-	void SetName(const std::string& n) { name = n; }
+	void SetName(const std::string& n);
 
 	friend class Scene;
 	friend class EntityPool;
+	friend class TestScene;
 };
 
 #endif // !_ENTITY_H_
@@ -40,9 +40,11 @@ void MeshRenderer::Render()
 	if (hideMesh)
 		return;
 
-	// World matrix
-	Matrix4x4 mWorld = GetWorldMatrix();
+	RenderMesh(mesh, GetWorldMatrix(), meshColor, renderBackSide);
+}
 
+void MeshRenderer::RenderMesh(const Mesh& mesh, const Matrix4x4& mWorld, const Vector3& meshColor, bool renderBackSide)
+{
 	// View matrix
 	Matrix4x4 mView = RenderSystem::Get().GetViewMatrix();
 
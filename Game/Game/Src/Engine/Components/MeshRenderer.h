@@ -37,6 +37,11 @@ public:
 	void LoadMesh(Mesh&);
 	Matrix4x4 GetWorldMatrix();
 
+	/**
+	 * @brief Draw a mesh with the current camera. Used by anything that renders meshes without a MeshRenderer.
+	 */
+	static void RenderMesh(const Mesh& mesh, const Matrix4x4& mWorld, const Vector3& meshColor, bool renderBackSide);
+
 	const Mesh& GetMesh() { return mesh; }
 	void SetHideMesh(bool value) { hideMesh = value; }
 	void SetRenderBackSide(bool value) { renderBackSide = value; }
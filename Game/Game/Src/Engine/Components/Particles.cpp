@@ -10,12 +10,31 @@
 #include "Engine/Math/Random.h"
 #include "Engine/Math/Matrix4x4.h"
 #include "Engine/Systems/RenderSystem.h"
+#include "Engine/Pools/ComponentAllocator.h"
 
 Particles::Particles()
 {
 	type = ParticlesC;
-	particlePool.clear();
-	particlePool.resize(maxParticles);
+	// Particles only touch their own pool, so they are simulated in parallel by the engine
+	isUpdatedBySystem = true;
+	isParallelSafe = true;
+	// A reused buffer still holds the particles of its previous owner
+	particlePool = static_cast<Particle*>(GetParticleBuffers().Allocate());
+	for (size_t i = 0; i < maxParticles; i++)
+	{
+		new (&particlePool[i]) Particle();
+	}
+}
+
+Particles::~Particles()
+{
+	GetParticleBuffers().Free(particlePool);
+}
+
+SlabAllocator& Particles::GetParticleBuffers()
+{
+	static SlabAllocator particleBuffers(maxParticles * sizeof(Particle));
+	return particleBuffers;
 }
 
 void Particles::Emit(int num, Vector3 direction)
@@ -41,15 +60,16 @@ void Particles::Emit(int num, Vector3 direction)
 			InitiateStarParticle(particle);
 
 		--num;
-		particleIdx = (++particleIdx) % particlePool.size();
+		particleIdx = (++particleIdx) % maxParticles;
 	}
 }
 
 void Particles::Update(float deltaTime)
 {
 	// Update the existing particles
-	for (Particle& particle : particlePool)
+	for (size_t i = 0; i < maxParticles; i++)
 	{
+		Particle& particle = particlePool[i];
 		if (!particle.isActive)
 			continue;
 
@@ -87,8 +107,9 @@ void Particles::Render()
 	// Projection matrix
 	Matrix4x4 mProj = RenderSystem::Get().GetProjectionMatrix();
 
-	for (Particle& particle : particlePool)
+	for (size_t i = 0; i < maxParticles; i++)
 	{
+		Particle& particle = particlePool[i];
 		if (!particle.isActive)
 			continue;
 
@@ -11,6 +11,8 @@
 #include "Engine/Math/Vector3.h"
 #include "Engine/Math/Triangle.h"
 
+class SlabAllocator;
+
 enum ParticleType
 {
 	EXPLOSION,
@@ -23,7 +25,7 @@ class Particles : public Renderable
 {
 private:
 	ParticleType particleType = EXPLOSION;
-	const size_t maxParticles = 500;
+	static const size_t maxParticles = 500;
 
 	// Configurable props
 	Vector3 positionOffset{ 0.0f, 0.0f, 0.0f };  // Difference between entity position & particle position
@@ -58,7 +60,14 @@ private:
 	};
 
 	size_t particleIdx = 0;
-	std::vector<Particle> particlePool;
+	// maxParticles particles, from a buffer shared by all the Particles components (see GetParticleBuffers)
+	Particle* particlePool = nullptr;
+
+	/**
+	 * @brief Buffers of maxParticles particles. Freed buffers are handed out again, so particle systems
+	 * coming & going don't touch the heap. Main thread only, like component creation.
+	 */
+	static SlabAllocator& GetParticleBuffers();
 
 	// Utility functions
 	void ComputeLineVertices(const Vector3& center, float length, float rotation, Vector3& edge1, Vector3& edge2);
@@ -71,7 +80,7 @@ private:
 
 protected:
 	// Protected destructor so that only Entity can delete it
-	~Particles() = default;
+	~Particles();
 
 	void Initialize() override { }
 	void Update(float) override;
@@ -89,6 +98,8 @@ public:
 
 	// Emit n particles
 	void Emit(int num, Vector3 direction = {0.0f, 0.0f, 0.0f});
+
+	friend class TestComponentAllocator;
 };
 
 #endif // !_PARTICLES_H_
@@ -8,6 +8,7 @@
 #define _Renderable_H_
 
 #include "Engine/Components/Component.h"
+#include "Engine/Core/DenseRegistry.h"
 
 /**
  * @class Renderable
@@ -21,6 +22,9 @@ protected:
 	~Renderable() = default;
 
 private:
+	// Handle of the renderable in RenderSystem
+	RegistryHandle renderHandle = INVALID_REGISTRY_HANDLE;
+
 	virtual void Render() = 0;
 
 	friend class RenderSystem;
@@ -8,22 +8,62 @@
 #include "Engine/Components/Collider.h"
 #include "Engine/Components/BoxCollider.h"
 #include "Engine/Core/Logger.h"
+#include "Engine/Systems/SceneManager.h"
+#include "Engine/Systems/Scene.h"
 
 void RigidBody::Initialize()
 {
 	// Check if it has collider. If yes, cache it
 	Component* component = GetEntity()->GetComponent(BoxColliderC);
 	if (component != nullptr)
+	{
 		collider = static_cast<BoxCollider*>(component);
+		collider->rigidBody = this;
+	}
+
+	// Entities coming back from the pool must not stay asleep
+	WakeUp();
 }
 
 void RigidBody::ApplyForce(const Vector3& force)
 {
 	// Force causes acceleration
 	instAcceleration += force / mass;
+	WakeUp();
 }
 
 void RigidBody::SetVelocity(const Vector3& v)
 {
 	velocity = v;
+	WakeUp();
+}
+
+void RigidBody::SetKinematic(bool value)
+{
+	isKinematic = value;
+	hasKinematicTarget = false;
+	velocity.Reset();
+	instAcceleration.Reset();
+	WakeUp();
+}
+
+void RigidBody::MoveKinematic(const Vector3& position)
+{
+	if (!isKinematic)
+	{
+		// Parallel-safe components (DoorOpener) call this from the workers & the logger isn't thread-safe
+		SceneManager::Get().GetActiveScene()->Defer([]() {
+			Logger::Get().Log("MoveKinematic called on a dynamic rigid body", WARNING_LOG);
+		});
+		return;
+	}
+
+	kinematicTarget = position;
+	hasKinematicTarget = true;
+}
+
+void RigidBody::WakeUp()
+{
+	isSleeping = false;
+	restingTime = 0.0f;
 }
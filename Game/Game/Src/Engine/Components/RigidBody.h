@@ -8,6 +8,7 @@
 
 #include "Engine/Components/Component.h"
 #include "Engine/Math/Vector3.h"
+#include "Engine/Core/DenseRegistry.h"
 
 class Collider;
 
@@ -15,7 +16,9 @@ class RigidBody : public Component
 {
 public:
 	float mass = 1.0f;
-	float drag = 0.01f;  // or friction
+	float drag = 0.01f;  // air resistance
+	// Friction coefficient used at contacts
+	float friction = 0.4f;
 	// Restitution coefficient
 	// e == 0: Perfectly inelastic collision
 	// 0 < e < 1: Partially elastic collision
@@ -34,9 +37,44 @@ public:
 	void ApplyForce(const Vector3&);
 	void SetVelocity(const Vector3&);
 
+	bool IsSleeping() const { return isSleeping; }
+	// Make the physics system simulate this body again
+	void WakeUp();
+
+	/**
+	 * @brief Kinematic bodies are moved by scripts (using MoveKinematic) instead of forces & collisions.
+	 * They push the dynamic bodies they hit, but nothing pushes them back.
+	 */
+	void SetKinematic(bool value);
+	bool IsKinematic() const { return isKinematic; }
+	/**
+	 * @brief Move a kinematic body to a position in the next physics update.
+	 * Its velocity is derived from the move, so the bodies it hits get pushed along.
+	 * A kinematic body that isn't moved in a frame has zero velocity.
+	 */
+	void MoveKinematic(const Vector3& position);
+
 	void Initialize() override;
 	void Update(float) override {}
 	void Destroy() override {}
+
+private:
+	// A body that stays (almost) still for a while is put to sleep by the physics system.
+	// Sleeping bodies are not simulated till something wakes them up.
+	bool isSleeping = false;
+	// Seconds for which the body has been (almost) still
+	float restingTime = 0.0f;
+
+	bool isKinematic = false;
+	// Position requested by MoveKinematic for the next physics update
+	bool hasKinematicTarget = false;
+	Vector3 kinematicTarget;
+	// Index of the body in its island while the island is being simulated, -1 otherwise
+	int solverIndex = -1;
+	// Handle of the body in PhysicsSystem
+	RegistryHandle physicsHandle = INVALID_REGISTRY_HANDLE;
+
+	friend class PhysicsSystem;
 };
 
 #endif // !_RIGID_BODY_H_
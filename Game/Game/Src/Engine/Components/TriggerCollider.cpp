@@ -0,0 +1,44 @@
+// @file: TriggerCollider.cpp
+//
+// @brief: Cpp file for TriggerCollider class. A box volume which reports the colliders entering & leaving it.
+
+#include "stdafx.h"
+#include "Engine/Components/TriggerCollider.h"
+#include "Engine/Components/Entity.h"
+#include "Engine/Components/Transform.h"
+#include "Engine/Systems/CollisionSystem.h"
+
+void TriggerCollider::Initialize()
+{
+	// Triggers don't need a mesh renderer. Build the box right away so that it's correct in the first BVH.
+	Callibrate();
+}
+
+void TriggerCollider::Callibrate()
+{
+	Vector3 center = GetEntity()->GetTransform().position + offset;
+	Vector3 minC = center - halfExtents;
+	Vector3 maxC = center + halfExtents;
+
+	if (minC != boundingBox.minCoords || maxC != boundingBox.maxCoords)
+	{
+		boundingBox.minCoords = minC;
+		boundingBox.maxCoords = maxC;
+		gotUpdated = true;
+
+		// BVH nodes above this trigger are stale till the next BVH update
+		CollisionSystem::Get().MarkColliderMoved(this);
+	}
+}
+
+void TriggerCollider::OnTriggerEnter(Collider* other)
+{
+	if (OnTriggerEnterFunc != nullptr)
+		OnTriggerEnterFunc(other);
+}
+
+void TriggerCollider::OnTriggerExit(Collider* other)
+{
+	if (OnTriggerExitFunc != nullptr)
+		OnTriggerExitFunc(other);
+}
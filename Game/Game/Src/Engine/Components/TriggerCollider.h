@@ -0,0 +1,62 @@
+// @file: TriggerCollider.h
+//
+// @brief: Header file for TriggerCollider class. A box volume which reports the colliders entering & leaving it.
+
+#pragma once
+#ifndef _TRIGGER_COLLIDER_H_
+#define _TRIGGER_COLLIDER_H_
+
+#include "Engine/Components/BoxCollider.h"
+
+/**
+ * @class TriggerCollider
+ *
+ * Trigger is a box around the entity's position which nothing collides with.
+ * It lives in the broadphase with the other box colliders, and the collision system tells it
+ * when a collider that activates triggers (see Collider::SetActivatesTriggers) enters or leaves it.
+ *
+ * Box is independent of the mesh, so an entity can have both a box collider & a trigger.
+ */
+class TriggerCollider : public BoxCollider
+{
+	using OnTriggerCallback = std::function<void(Collider*)>;
+
+	// Box relative to the entity's position
+	Vector3 offset{ 0.0f, 0.0f, 0.0f };
+	Vector3 halfExtents{ 0.5f, 0.5f, 0.5f };
+
+	// Only colliders with this tag set off the trigger. GENERIC means all of them.
+	ColliderTag triggerTag = GENERIC;
+
+	OnTriggerCallback OnTriggerEnterFunc = nullptr;
+	OnTriggerCallback OnTriggerExitFunc = nullptr;
+
+	/**
+	 * @brief Construct the box from the entity's position
+	 */
+	void Callibrate() override;
+
+public:
+	TriggerCollider() { type = TriggerColliderC; isTrigger = true; }
+
+	void Initialize() override;
+
+	void SetBox(const Vector3& boxOffset, const Vector3& boxHalfExtents) { offset = boxOffset; halfExtents = boxHalfExtents; }
+	void SetTriggerTag(ColliderTag tag) { triggerTag = tag; }
+	ColliderTag GetTriggerTag() const { return triggerTag; }
+
+	void SetOnTriggerEnterCallback(OnTriggerCallback callback) { OnTriggerEnterFunc = callback; }
+	void SetOnTriggerExitCallback(OnTriggerCallback callback) { OnTriggerExitFunc = callback; }
+
+	/**
+	 * @brief Called by the collision system when a collider starts / stops overlapping the trigger.
+	 */
+	void OnTriggerEnter(Collider* other);
+	void OnTriggerExit(Collider* other);
+
+	bool DidCollide(Collider*) override { return false; }
+
+	friend class CollisionSystem;
+};
+
+#endif // !_TRIGGER_COLLIDER_H_
@@ -0,0 +1,141 @@
+// @file: DenseRegistry.h
+//
+// @brief: Header file for DenseRegistry, a container with O(1) add / remove and contiguous iteration.
+
+#pragma once
+#ifndef _DENSE_REGISTRY_H_
+#define _DENSE_REGISTRY_H_
+
+// Handle given out by a DenseRegistry. Lower bits are the slot index, upper bits are the slot generation.
+using RegistryHandle = unsigned int;
+const RegistryHandle INVALID_REGISTRY_HANDLE = 0xFFFFFFFF;
+
+/**
+ * @class DenseRegistry
+ *
+ * Items are kept packed in a vector, so iterating over them is as fast as it gets.
+ * Removal moves the last item into the hole (swap-and-pop), so the order of items is NOT stable.
+ *
+ * Every item gets a handle which stays valid till the item is removed, no matter how many times
+ * the item moves inside the vector. The owner of the item keeps this handle to remove it in O(1).
+ * Handles of removed items become invalid, even if their slot gets reused by a new item.
+ */
+template <typename T>
+class DenseRegistry
+{
+	static const unsigned int INDEX_BITS = 20;
+	static const unsigned int INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static const unsigned int GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+	// Packed items
+	std::vector<T> items;
+	// Slot of every packed item
+	std::vector<unsigned int> itemSlots;
+
+	// Index of the item in the packed vector, for every slot
+	std::vector<unsigned int> slotItems;
+	// Bumped every time the item of a slot gets removed
+	std::vector<unsigned int> slotGenerations;
+	std::vector<unsigned int> freeSlots;
+
+public:
+	using iterator = typename std::vector<T>::iterator;
+	using const_iterator = typename std::vector<T>::const_iterator;
+
+	RegistryHandle Add(const T& item)
+	{
+		unsigned int slot;
+		if (!freeSlots.empty())
+		{
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else
+		{
+			slot = static_cast<unsigned int>(slotItems.size());
+			assert(slot < INDEX_MASK);
+			slotItems.push_back(0);
+			slotGenerations.push_back(0);
+		}
+
+		slotItems[slot] = static_cast<unsigned int>(items.size());
+		items.push_back(item);
+		itemSlots.push_back(slot);
+
+		return (slotGenerations[slot] << INDEX_BITS) | slot;
+	}
+
+	/**
+	 * @brief Remove the item of a handle. The last item takes its place.
+	 * @return False if the handle was already invalid.
+	 */
+	bool Remove(RegistryHandle handle)
+	{
+		if (!IsValid(handle))
+			return false;
+
+		unsigned int slot = handle & INDEX_MASK;
+		unsigned int index = slotItems[slot];
+		unsigned int lastIndex = static_cast<unsigned int>(items.size()) - 1;
+		if (index != lastIndex)
+		{
+			items[index] = std::move(items[lastIndex]);
+			itemSlots[index] = itemSlots[lastIndex];
+			slotItems[itemSlots[index]] = index;
+		}
+		items.pop_back();
+		itemSlots.pop_back();
+
+		// Old handles of this slot must not match the next item using it
+		slotGenerations[slot] = (slotGenerations[slot] + 1) & GENERATION_MASK;
+		freeSlots.push_back(slot);
+		return true;
+	}
+
+	bool IsValid(RegistryHandle handle) const
+	{
+		if (handle == INVALID_REGISTRY_HANDLE)
+			return false;
+
+		unsigned int slot = handle & INDEX_MASK;
+		return slot < slotGenerations.size() && slotGenerations[slot] == (handle >> INDEX_BITS);
+	}
+
+	// Returns nullptr if the handle is invalid
+	T* Get(RegistryHandle handle)
+	{
+		if (!IsValid(handle))
+			return nullptr;
+		return &items[slotItems[handle & INDEX_MASK]];
+	}
+	const T* Get(RegistryHandle handle) const
+	{
+		if (!IsValid(handle))
+			return nullptr;
+		return &items[slotItems[handle & INDEX_MASK]];
+	}
+
+	void Clear()
+	{
+		for (unsigned int slot : itemSlots)
+		{
+			slotGenerations[slot] = (slotGenerations[slot] + 1) & GENERATION_MASK;
+			freeSlots.push_back(slot);
+		}
+		items.clear();
+		itemSlots.clear();
+	}
+
+	size_t Size() const { return items.size(); }
+	bool IsEmpty() const { return items.empty(); }
+
+	T& operator[](size_t index) { return items[index]; }
+	const T& operator[](size_t index) const { return items[index]; }
+
+	iterator begin() { return items.begin(); }
+	iterator end() { return items.end(); }
+	const_iterator begin() const { return items.begin(); }
+	const_iterator end() const { return items.end(); }
+};
+
+#endif // !_DENSE_REGISTRY_H_
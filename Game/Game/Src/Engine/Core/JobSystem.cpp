@@ -0,0 +1,201 @@
+// @file: JobSystem.cpp
+//
+// @brief: Cpp file for JobSystem, a singleton owning the worker threads used for running engine work in parallel.
+
+#include "stdafx.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Logger.h"
+
+// Index of the queue owned by the current thread (see GetThreadIndex)
+static thread_local size_t currentThreadIndex = 0;
+
+void JobSystem::Initialize()
+{
+	// hardware_concurrency can return 0 if it is unable to detect the core count
+	unsigned int cores = std::thread::hardware_concurrency();
+	Initialize((cores > 1) ? static_cast<size_t>(cores - 1) : 0);
+}
+
+void JobSystem::Initialize(size_t numWorkers)
+{
+	if (!workers.empty())
+		return;
+
+	stopWorkers = false;
+
+	// Queues must all exist before any worker starts stealing
+	queues.clear();
+	for (size_t i = 0; i < numWorkers + 1; i++)
+	{
+		queues.emplace_back(new JobQueue());
+	}
+	for (size_t i = 0; i < numWorkers; i++)
+	{
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+	Logger::Get().Log("Job system started with " + std::to_string(numWorkers) + " worker threads.");
+}
+
+void JobSystem::Destroy()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopWorkers = true;
+	}
+	jobsAvailable.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+	workers.clear();
+	queues.clear();
+}
+
+size_t JobSystem::GetThreadIndex()
+{
+	return currentThreadIndex;
+}
+
+void JobSystem::WorkerLoop(size_t threadIndex)
+{
+	currentThreadIndex = threadIndex;
+
+	std::function<void()> job;
+	while (true)
+	{
+		if (PopJob(threadIndex, job))
+		{
+			job();
+			job = nullptr;
+			continue;
+		}
+
+		// Nothing to run or steal. Jobs left at stop are still run before the worker quits.
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		jobsAvailable.wait(lock, [this]() { return stopWorkers || pendingJobs.load() > 0; });
+		if (stopWorkers && pendingJobs.load() == 0)
+			return;
+	}
+}
+
+void JobSystem::PushJob(std::function<void()> job)
+{
+	JobQueue& queue = *queues[currentThreadIndex];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(std::move(job));
+	}
+	pendingJobs.fetch_add(1);
+
+	// Taking the lock makes sure a worker about to sleep either sees the job or gets the notification
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	jobsAvailable.notify_one();
+}
+
+bool JobSystem::PopJob(size_t threadIndex, std::function<void()>& job)
+{
+	// Own queue first, newest job
+	{
+		JobQueue& queue = *queues[threadIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			pendingJobs.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// Steal the oldest job of another queue. Starting from the next queue spreads the thieves out.
+	for (size_t i = 1; i < queues.size(); i++)
+	{
+		JobQueue& victim = *queues[(threadIndex + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty())
+		{
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			pendingJobs.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::ParallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+	if (count == 0)
+		return;
+
+	if (workers.empty() || count == 1)
+	{
+		for (size_t i = 0; i < count; i++)
+			func(i);
+		return;
+	}
+
+	// Shared with the helpers. A helper may start after ParallelFor has returned (its worker was busy
+	// with a background job), so it must not reference this stack frame.
+	struct ParallelForState
+	{
+		std::atomic<size_t> nextIndex{ 0 };
+		std::atomic<size_t> doneIndices{ 0 };
+		size_t count = 0;
+		size_t batchSize = 1;
+		const std::function<void(size_t)>* func = nullptr;
+	};
+	std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+	state->count = count;
+	state->func = &func;
+
+	// The calling thread is a helper too, so ask for at most (count - 1) workers
+	size_t numHelpers = std::min(workers.size(), count - 1);
+	// Indices are handed out in small batches: few enough to keep the atomics cold (entities are cheap to update),
+	// many enough that an expensive batch doesn't hold back the rest
+	state->batchSize = std::max<size_t>(1, count / ((numHelpers + 1) * 8));
+
+	// Late helpers find no index left & never touch func
+	auto processIndices = [state]() {
+		size_t begin = state->nextIndex.fetch_add(state->batchSize);
+		while (begin < state->count)
+		{
+			size_t end = std::min(begin + state->batchSize, state->count);
+			for (size_t index = begin; index < end; index++)
+			{
+				(*state->func)(index);
+			}
+			state->doneIndices.fetch_add(end - begin);
+			begin = state->nextIndex.fetch_add(state->batchSize);
+		}
+	};
+
+	// Helpers go to the caller's queue, idle workers steal them from there
+	for (size_t i = 0; i < numHelpers; i++)
+	{
+		PushJob(processIndices);
+	}
+
+	processIndices();
+
+	// Wait for the indices other helpers picked up. Helpers which haven't started aren't waited for.
+	while (state->doneIndices.load() < count)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::Schedule(std::function<void()> job)
+{
+	if (workers.empty())
+	{
+		job();
+		return;
+	}
+
+	PushJob(std::move(job));
+}
@@ -0,0 +1,104 @@
+// @file: JobSystem.h
+//
+// @brief: Header file for JobSystem, a singleton owning the worker threads used for running engine work in parallel.
+
+#pragma once
+#ifndef _JOB_SYSTEM_H_
+#define _JOB_SYSTEM_H_
+
+/**
+ * @class JobSystem
+ *
+ * JobSystem keeps a fixed set of worker threads alive for the whole game.
+ * Creating threads is slow, so systems hand their parallel work to these workers instead.
+ *
+ * Every thread has its own job queue. A thread pushes & pops jobs at the back of its own queue (the newest job
+ * is the most likely to still be in cache), and a worker which runs out of jobs steals the oldest job from the
+ * front of another queue. Jobs spawned by a worker stay on that worker unless someone is idle, and nobody
+ * fights over a single queue.
+ *
+ * The thread calling ParallelFor also takes part in the work, so nothing is wasted while it waits.
+ * Long background jobs (Schedule) can share the workers, ParallelFor never waits for them.
+ */
+class JobSystem
+{
+	DECLARE_SINGLETON(JobSystem)
+
+	// Jobs of one thread. Its owner uses the back, thieves take from the front.
+	struct JobQueue
+	{
+		std::deque<std::function<void()>> jobs;
+		std::mutex mutex;
+	};
+
+	std::vector<std::thread> workers;
+	// Queue 0 belongs to the threads which are not workers (the main thread), queue i + 1 to worker i
+	std::vector<std::unique_ptr<JobQueue>> queues;
+
+	// Jobs in all the queues. Idle workers sleep till there is one.
+	std::atomic<size_t> pendingJobs{ 0 };
+	std::mutex sleepMutex;
+	std::condition_variable jobsAvailable;
+	bool stopWorkers = false;
+
+	// Loop run by each worker thread. Picks up jobs till the job system is destroyed.
+	void WorkerLoop(size_t threadIndex);
+
+	/**
+	 * @brief Add a job to the queue of the calling thread & wake up a worker.
+	 */
+	void PushJob(std::function<void()> job);
+	/**
+	 * @brief Take the newest job of the thread's own queue, or steal the oldest job of another queue.
+	 *
+	 * @return False if all the queues are empty.
+	 */
+	bool PopJob(size_t threadIndex, std::function<void()>& job);
+
+public:
+	/**
+	 * @brief Call func for every index in [0, count). Calls are spread across the worker threads.
+	 * Returns only after all the calls have finished.
+	 * If there are no workers (or just 1 index), everything runs on the calling thread.
+	 *
+	 * @param count Number of indices
+	 * @param func Function to be called with each index. Must be safe to call concurrently.
+	 */
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func);
+
+	/**
+	 * @brief Run a long job (like a BVH build) on a worker thread. Returns right away.
+	 * The caller must find out on its own when the job is done (an atomic flag for example).
+	 * If there are no workers, the job runs on the calling thread before returning.
+	 */
+	void Schedule(std::function<void()> job);
+
+	size_t GetWorkerCount() const { return workers.size(); }
+	/**
+	 * @brief Index of the calling thread: 0 for any thread which isn't a worker (the main thread), i + 1 for worker i.
+	 * Useful for keeping per-thread data without locks. Indices are below GetWorkerCount() + 1.
+	 */
+	static size_t GetThreadIndex();
+
+protected:
+	/**
+	 * @brief Start the worker threads. One core is left for the main thread.
+	 */
+	void Initialize();
+	/**
+	 * @brief Start a fixed number of worker threads, whatever the core count. Used by the tests.
+	 */
+	void Initialize(size_t numWorkers);
+
+	/**
+	 * @brief Stop & join all the worker threads.
+	 */
+	void Destroy();
+
+	friend class Engine;
+	friend class TestJobSystem;
+	friend class TestSystemScheduler;
+	friend class TestScene;
+};
+
+#endif // !_JOB_SYSTEM_H_
@@ -16,10 +16,16 @@ protected:
 	std::string guid = "";
 	STRCODE uid = 0;
 
+	// Index in the ObjectPool which created the object, so that it can be freed without a lookup
+	size_t poolIndex = NO_POOL_INDEX;
+	bool isFreeInPool = false;
+
 	Object();
 	Object(std::string& guid);
 
 public:
+	static const size_t NO_POOL_INDEX = static_cast<size_t>(-1);
+
 	virtual ~Object() = default;
 
 	virtual void Initialize() = 0;
@@ -31,6 +37,8 @@ public:
 	const STRCODE GetUid() const { return uid; }
 
 	bool IsEntity() const { return isEntity; }
+
+	friend class ObjectPool;
 };
 
 #endif // !_OBJECT_H_
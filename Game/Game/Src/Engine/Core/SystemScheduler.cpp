@@ -0,0 +1,187 @@
+// @file: SystemScheduler.cpp
+//
+// @brief: Cpp file for SystemScheduler, which runs the engine systems of a frame as a dependency graph.
+
+#include "stdafx.h"
+#include "Engine/Core/SystemScheduler.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Logger.h"
+
+// --------------------------- Private member functions ---------------------------
+
+void SystemScheduler::Build()
+{
+	WaitForQueuedJobs();
+
+	for (size_t i = 0; i < systems.size(); i++)
+	{
+		systems[i].dependencies.clear();
+		systems[i].dependents.clear();
+	}
+
+	for (size_t later = 0; later < systems.size(); later++)
+	{
+		const System& b = systems[later];
+		for (size_t earlier = 0; earlier < later; earlier++)
+		{
+			const System& a = systems[earlier];
+			bool conflicts = (a.writes & (b.reads | b.writes)) || (a.reads & b.writes);
+			if (conflicts)
+			{
+				systems[later].dependencies.push_back(earlier);
+				systems[earlier].dependents.push_back(later);
+			}
+		}
+	}
+
+	pendingDependencies.reset(new std::atomic<size_t>[systems.size()]);
+	claimedFrame.reset(new std::atomic<unsigned int>[systems.size()]);
+	for (size_t i = 0; i < systems.size(); i++)
+	{
+		claimedFrame[i].store(0);
+	}
+	frame = 0;
+	isBuilt = true;
+}
+
+void SystemScheduler::MakeReady(size_t index, unsigned int runFrame, float deltaTime)
+{
+	{
+		std::lock_guard<std::mutex> lock(readyMutex);
+		readySystems.push_back(index);
+	}
+
+	// The main thread would pick it up too, but a worker can start on it right away
+	if (!systems[index].mainThreadOnly)
+	{
+		queuedJobs.fetch_add(1);
+		JobSystem::Get().Schedule([this, index, runFrame, deltaTime]() {
+			TryRun(index, runFrame, deltaTime);
+			queuedJobs.fetch_sub(1);
+		});
+	}
+}
+
+void SystemScheduler::TryRun(size_t index, unsigned int runFrame, float deltaTime)
+{
+	// Fails if the system was picked up already, or if this is a late job of an earlier frame
+	unsigned int expected = runFrame - 1;
+	if (!claimedFrame[index].compare_exchange_strong(expected, runFrame))
+		return;
+
+	System& system = systems[index];
+	auto start = std::chrono::high_resolution_clock::now();
+	system.func(deltaTime);
+	auto end = std::chrono::high_resolution_clock::now();
+
+	system.lastTime = std::chrono::duration<float, std::milli>(end - start).count();
+	system.totalTime += system.lastTime;
+	system.maxTime = std::max(system.maxTime, system.lastTime);
+	system.runs++;
+
+	for (size_t dependent : system.dependents)
+	{
+		if (pendingDependencies[dependent].fetch_sub(1) == 1)
+			MakeReady(dependent, runFrame, deltaTime);
+	}
+	// Counted last, so Run doesn't return before the dependents are ready
+	finishedSystems.fetch_add(1);
+}
+
+void SystemScheduler::WaitForQueuedJobs()
+{
+	while (queuedJobs.load() > 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+// --------------------------- Public member functions ---------------------------
+
+SystemScheduler::~SystemScheduler()
+{
+	WaitForQueuedJobs();
+}
+
+size_t SystemScheduler::AddSystem(const std::string& name, std::function<void(float)> func, SystemResourceMask reads, SystemResourceMask writes, bool mainThreadOnly)
+{
+	System system;
+	system.name = name;
+	system.func = std::move(func);
+	system.reads = reads;
+	system.writes = writes;
+	system.mainThreadOnly = mainThreadOnly;
+	systems.push_back(std::move(system));
+
+	isBuilt = false;
+	return systems.size() - 1;
+}
+
+void SystemScheduler::Clear()
+{
+	WaitForQueuedJobs();
+	systems.clear();
+	isBuilt = false;
+}
+
+void SystemScheduler::Run(float deltaTime)
+{
+	if (systems.empty())
+		return;
+	if (!isBuilt)
+		Build();
+
+	++frame;
+	finishedSystems.store(0);
+	{
+		std::lock_guard<std::mutex> lock(readyMutex);
+		readySystems.clear();
+	}
+	for (size_t i = 0; i < systems.size(); i++)
+	{
+		pendingDependencies[i].store(systems[i].dependencies.size());
+	}
+
+	for (size_t i = 0; i < systems.size(); i++)
+	{
+		if (systems[i].dependencies.empty())
+			MakeReady(i, frame, deltaTime);
+	}
+
+	// Main thread runs the main thread systems & helps with the others till everything is done
+	while (finishedSystems.load() < systems.size())
+	{
+		size_t index = NO_SYSTEM;
+		{
+			std::lock_guard<std::mutex> lock(readyMutex);
+			if (!readySystems.empty())
+			{
+				index = readySystems.back();
+				readySystems.pop_back();
+			}
+		}
+
+		if (index != NO_SYSTEM)
+			TryRun(index, frame, deltaTime);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void SystemScheduler::LogTimings()
+{
+	for (System& system : systems)
+	{
+		if (system.runs == 0)
+			continue;
+
+		std::ostringstream logMsg;
+		logMsg << std::fixed << std::setprecision(3) << "System " << system.name << ": avg " << (system.totalTime / system.runs)
+			<< " ms, max " << system.maxTime << " ms" << (system.mainThreadOnly ? "" : " (worker)");
+		Logger::Get().Log(logMsg.str(), DEBUG_LOG);
+
+		system.totalTime = 0.0f;
+		system.maxTime = 0.0f;
+		system.runs = 0;
+	}
+}
@@ -0,0 +1,129 @@
+// @file: SystemScheduler.h
+//
+// @brief: Header file for SystemScheduler, which runs the engine systems of a frame as a dependency graph.
+
+#pragma once
+#ifndef _SYSTEM_SCHEDULER_H_
+#define _SYSTEM_SCHEDULER_H_
+
+// Engine state a system can read or write
+enum SystemResource {
+	ENTITY_DATA,  // entities, their components & everything game code touches
+	TRANSFORM_DATA,
+	RIGIDBODY_DATA,
+	COLLIDER_DATA,
+	BVH_DATA,
+	MOVED_COLLIDER_DATA,  // colliders moved since the BVH update, checked by the collision queries directly
+	CAMERA_DATA,
+	PARTICLE_DATA,
+	DEBRIS_DATA,
+	UI_DATA  // state of the UI managers (messages & their timers)
+};
+
+// Set of system resources. Build it with SystemResourceBit.
+using SystemResourceMask = unsigned int;
+const SystemResourceMask ALL_SYSTEM_RESOURCES = 0xFFFFFFFF;
+inline SystemResourceMask SystemResourceBit(SystemResource resource) { return 1u << resource; }
+
+/**
+ * @class SystemScheduler
+ *
+ * Systems are added in the order they would run one after another. Each one declares what it reads & writes.
+ * A system depends on every earlier system it conflicts with (one of them writes what the other one touches),
+ * so the result is always the same as running them in order.
+ *
+ * Systems without a path between them run at the same time: ready systems are handed to the JobSystem workers,
+ * while the main thread runs the systems which must stay on it (game code, logging) & helps with the rest.
+ */
+class SystemScheduler
+{
+	friend class TestSystemScheduler;
+
+	static const size_t NO_SYSTEM = static_cast<size_t>(-1);
+
+	struct System
+	{
+		std::string name;
+		std::function<void(float)> func;
+		SystemResourceMask reads = 0;
+		SystemResourceMask writes = 0;
+		bool mainThreadOnly = false;
+
+		// Earlier systems this one waits for & later systems waiting for this one
+		std::vector<size_t> dependencies;
+		std::vector<size_t> dependents;
+
+		// In ms
+		float lastTime = 0.0f;
+		float totalTime = 0.0f;
+		float maxTime = 0.0f;
+		size_t runs = 0;
+	};
+	std::vector<System> systems;
+	bool isBuilt = false;
+
+	// ---------------- State of the running frame ----------------
+	unsigned int frame = 0;
+	// Dependencies each system still waits for
+	std::unique_ptr<std::atomic<size_t>[]> pendingDependencies;
+	// Last frame each system was picked up in. Whoever moves it to the running frame runs the system.
+	std::unique_ptr<std::atomic<unsigned int>[]> claimedFrame;
+	std::atomic<size_t> finishedSystems{ 0 };
+	// Systems whose dependencies are done. Worker systems are also handed to the JobSystem.
+	std::vector<size_t> readySystems;
+	std::mutex readyMutex;
+	// Jobs handed to the JobSystem which haven't returned yet. A job can outlive its frame (the main thread ran
+	// the system first), so the systems must not go away till they are all back.
+	std::atomic<size_t> queuedJobs{ 0 };
+
+	void WaitForQueuedJobs();
+
+	/**
+	 * @brief Find the dependencies of every system.
+	 */
+	void Build();
+
+	void MakeReady(size_t index, unsigned int runFrame, float deltaTime);
+	/**
+	 * @brief Run a ready system unless another thread picked it up already.
+	 */
+	void TryRun(size_t index, unsigned int runFrame, float deltaTime);
+
+public:
+	SystemScheduler() = default;
+	~SystemScheduler();
+
+	/**
+	 * @brief Add a system. It runs after all the earlier systems it conflicts with.
+	 *
+	 * @param name Shown in the timings
+	 * @param func Called with the frame's deltaTime
+	 * @param reads Resources read by the system (SystemResourceBit)
+	 * @param writes Resources written by the system
+	 * @param mainThreadOnly Must run on the main thread (game code, App calls, logging)
+	 * @return Index of the system
+	 */
+	size_t AddSystem(const std::string& name, std::function<void(float)> func, SystemResourceMask reads, SystemResourceMask writes, bool mainThreadOnly);
+
+	/**
+	 * @brief Remove all the systems.
+	 */
+	void Clear();
+
+	/**
+	 * @brief Run all the systems once. Returns when all of them have finished.
+	 */
+	void Run(float deltaTime);
+
+	size_t GetSystemCount() const { return systems.size(); }
+	const std::string& GetName(size_t index) const { return systems[index].name; }
+	// In ms, for the last Run
+	float GetLastTime(size_t index) const { return systems[index].lastTime; }
+
+	/**
+	 * @brief Log the average & worst time of each system since the last call, then reset them.
+	 */
+	void LogTimings();
+};
+
+#endif // !_SYSTEM_SCHEDULER_H_
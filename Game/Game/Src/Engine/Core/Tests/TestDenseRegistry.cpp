@@ -0,0 +1,92 @@
+// @file: TestDenseRegistry.cpp
+//
+// @brief: Cpp file for TestDenseRegistry class containing unit tests for DenseRegistry class.
+
+#include "stdafx.h"
+#include "TestDenseRegistry.h"
+#include "Engine/Core/DenseRegistry.h"
+#include "Engine/Core/Logger.h"
+
+void TestDenseRegistry::RunTests()
+{
+	TestAdd();
+	TestRemove();
+	TestStaleHandle();
+	TestClear();
+	Logger::Get().Log("[UNITTEST] DenseRegistry - All tests passed!");
+}
+
+void TestDenseRegistry::TestAdd()
+{
+	DenseRegistry<int> registry;
+	RegistryHandle h1 = registry.Add(10);
+	RegistryHandle h2 = registry.Add(20);
+
+	assert(registry.Size() == 2);
+	assert(h1 != h2);
+	assert(*registry.Get(h1) == 10);
+	assert(*registry.Get(h2) == 20);
+	// Items are packed in the order they were added
+	assert(registry[0] == 10 && registry[1] == 20);
+}
+
+void TestDenseRegistry::TestRemove()
+{
+	DenseRegistry<int> registry;
+	RegistryHandle h1 = registry.Add(10);
+	RegistryHandle h2 = registry.Add(20);
+	RegistryHandle h3 = registry.Add(30);
+
+	// Last item fills the hole
+	assert(registry.Remove(h1));
+	assert(registry.Size() == 2);
+	assert(registry[0] == 30 && registry[1] == 20);
+
+	// Handles of the moved items still work
+	assert(*registry.Get(h2) == 20);
+	assert(*registry.Get(h3) == 30);
+
+	// Removing twice does nothing
+	assert(!registry.Remove(h1));
+	assert(registry.Size() == 2);
+
+	int sum = 0;
+	for (int item : registry)
+		sum += item;
+	assert(sum == 50);
+
+	assert(registry.Remove(h3));
+	assert(registry.Remove(h2));
+	assert(registry.IsEmpty());
+}
+
+void TestDenseRegistry::TestStaleHandle()
+{
+	DenseRegistry<int> registry;
+	RegistryHandle h1 = registry.Add(10);
+	registry.Remove(h1);
+
+	// New item reuses the slot, but the old handle must not reach it
+	RegistryHandle h2 = registry.Add(20);
+	assert(h1 != h2);
+	assert(!registry.IsValid(h1));
+	assert(registry.Get(h1) == nullptr);
+	assert(*registry.Get(h2) == 20);
+
+	assert(!registry.IsValid(INVALID_REGISTRY_HANDLE));
+}
+
+void TestDenseRegistry::TestClear()
+{
+	DenseRegistry<int> registry;
+	RegistryHandle h1 = registry.Add(10);
+	RegistryHandle h2 = registry.Add(20);
+	registry.Clear();
+
+	assert(registry.IsEmpty());
+	assert(!registry.IsValid(h1));
+	assert(!registry.IsValid(h2));
+
+	RegistryHandle h3 = registry.Add(30);
+	assert(*registry.Get(h3) == 30);
+}
@@ -0,0 +1,20 @@
+// @file: TestDenseRegistry.h
+//
+// @brief: Header file for TestDenseRegistry class containing unit tests for DenseRegistry class.
+
+#pragma once
+#ifndef _TEST_DENSE_REGISTRY_H_
+#define _TEST_DENSE_REGISTRY_H_
+
+class TestDenseRegistry
+{
+	static void TestAdd();
+	static void TestRemove();
+	static void TestStaleHandle();
+	static void TestClear();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_DENSE_REGISTRY_H_
@@ -0,0 +1,118 @@
+// @file: TestJobSystem.cpp
+//
+// @brief: Cpp file for TestJobSystem class containing unit tests for JobSystem class.
+
+#include "stdafx.h"
+#include "TestJobSystem.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Logger.h"
+
+// Workers started for the tests, whatever the core count. The engine starts its own ones later.
+static const size_t TEST_WORKER_COUNT = 3;
+
+void TestJobSystem::RunTests()
+{
+	assert(JobSystem::Get().GetWorkerCount() == 0);
+	JobSystem::Get().Initialize(TEST_WORKER_COUNT);
+	assert(JobSystem::Get().GetWorkerCount() == TEST_WORKER_COUNT);
+
+	TestParallelFor();
+	TestWorkersTakePart();
+	TestNestedParallelFor();
+	TestScheduleFromJobs();
+
+	JobSystem::Get().Destroy();
+	assert(JobSystem::Get().GetWorkerCount() == 0);
+	Logger::Get().Log("[UNITTEST] JobSystem - All tests passed!");
+}
+
+void TestJobSystem::TestParallelFor()
+{
+	assert(JobSystem::GetThreadIndex() == 0);
+
+	const size_t counts[] = { 0, 1, 7, 10000 };
+	for (size_t count : counts)
+	{
+		// Every index exactly once, on a valid thread
+		std::vector<std::atomic<int>> visits(count);
+		std::atomic<bool> badThread{ false };
+		JobSystem::Get().ParallelFor(count, [&visits, &badThread](size_t i) {
+			visits[i].fetch_add(1);
+			if (JobSystem::GetThreadIndex() > JobSystem::Get().GetWorkerCount())
+				badThread = true;
+		});
+		for (std::atomic<int>& visit : visits)
+			assert(visit.load() == 1);
+		assert(!badThread.load());
+	}
+
+	// Returns only after every call is done
+	std::atomic<size_t> sum{ 0 };
+	JobSystem::Get().ParallelFor(1000, [&sum](size_t i) {
+		std::this_thread::yield();
+		sum.fetch_add(i);
+	});
+	assert(sum.load() == 1000 * 999 / 2);
+}
+
+void TestJobSystem::TestWorkersTakePart()
+{
+	// Every call waits till some other thread has made one too, so the loop can only finish quickly if a worker
+	// takes part. The deadline turns a stuck run into a failed assert instead of a hang.
+	std::vector<std::atomic<bool>> threadsUsed(TEST_WORKER_COUNT + 1);
+	std::atomic<size_t> threadCount{ 0 };
+	JobSystem::Get().ParallelFor(64, [&threadsUsed, &threadCount](size_t) {
+		if (!threadsUsed[JobSystem::GetThreadIndex()].exchange(true))
+			threadCount.fetch_add(1);
+
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (threadCount.load() < 2 && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::yield();
+		}
+	});
+	assert(threadCount.load() >= 2);
+}
+
+void TestJobSystem::TestNestedParallelFor()
+{
+	// Workers running an outer index run an inner ParallelFor, their helpers get stolen by the others
+	const size_t outer = 16;
+	const size_t inner = 500;
+	std::atomic<size_t> total{ 0 };
+	JobSystem::Get().ParallelFor(outer, [&total, inner](size_t) {
+		JobSystem::Get().ParallelFor(inner, [&total](size_t) {
+			total.fetch_add(1);
+		});
+	});
+	assert(total.load() == outer * inner);
+}
+
+void TestJobSystem::TestScheduleFromJobs()
+{
+	// Each job spawns 2 more till the depth runs out: 2^6 - 1 jobs
+	std::atomic<int> finished{ 0 };
+	// Jobs which are done with spawn. A job still runs it after bumping finished, so spawn must outlive all of them.
+	std::atomic<int> returned{ 0 };
+	// The main thread only waits, so every job must have run on a worker
+	std::atomic<bool> ranOnMainThread{ false };
+	std::function<void(int)> spawn;
+	spawn = [&finished, &returned, &ranOnMainThread, &spawn](int depth) {
+		if (JobSystem::GetThreadIndex() == 0)
+			ranOnMainThread = true;
+		if (depth > 1)
+		{
+			JobSystem::Get().Schedule([&spawn, &returned, depth]() { spawn(depth - 1); returned.fetch_add(1); });
+			JobSystem::Get().Schedule([&spawn, &returned, depth]() { spawn(depth - 1); returned.fetch_add(1); });
+		}
+		finished.fetch_add(1);
+	};
+	JobSystem::Get().Schedule([&spawn, &returned]() { spawn(6); returned.fetch_add(1); });
+
+	while (returned.load() < 63)
+	{
+		std::this_thread::yield();
+	}
+	assert(finished.load() == 63);
+	assert(!ranOnMainThread.load());
+}
@@ -0,0 +1,20 @@
+// @file: TestJobSystem.h
+//
+// @brief: Header file for TestJobSystem class containing unit tests for JobSystem class.
+
+#pragma once
+#ifndef _TEST_JOB_SYSTEM_H_
+#define _TEST_JOB_SYSTEM_H_
+
+class TestJobSystem
+{
+	static void TestParallelFor();
+	static void TestWorkersTakePart();
+	static void TestNestedParallelFor();
+	static void TestScheduleFromJobs();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_JOB_SYSTEM_H_
@@ -0,0 +1,134 @@
+// @file: TestSystemScheduler.cpp
+//
+// @brief: Cpp file for TestSystemScheduler class containing unit tests for SystemScheduler class.
+
+#include "stdafx.h"
+#include "TestSystemScheduler.h"
+#include "Engine/Core/SystemScheduler.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Logger.h"
+
+void TestSystemScheduler::RunTests()
+{
+	// Systems which aren't main thread only must get picked up by workers
+	JobSystem::Get().Initialize(2);
+
+	TestDependencies();
+	TestOrder();
+	TestRepeatedRuns();
+	TestRunsOnWorkers();
+
+	JobSystem::Get().Destroy();
+	Logger::Get().Log("[UNITTEST] SystemScheduler - All tests passed!");
+}
+
+void TestSystemScheduler::TestDependencies()
+{
+	const SystemResourceMask a = SystemResourceBit(TRANSFORM_DATA);
+	const SystemResourceMask b = SystemResourceBit(PARTICLE_DATA);
+
+	SystemScheduler scheduler;
+	auto noop = [](float) {};
+	scheduler.AddSystem("Write A", noop, 0, a, false);
+	scheduler.AddSystem("Read A", noop, a, 0, false);
+	scheduler.AddSystem("Read A again", noop, a, 0, false);
+	scheduler.AddSystem("Write B", noop, 0, b, false);
+	scheduler.AddSystem("Write A after reads", noop, 0, a, false);
+	scheduler.AddSystem("Everything", noop, ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+	scheduler.Build();
+
+	const std::vector<SystemScheduler::System>& systems = scheduler.systems;
+	assert(systems[0].dependencies.empty());
+	// Reads wait for the write, but not for each other
+	assert(systems[1].dependencies == std::vector<size_t>{ 0 });
+	assert(systems[2].dependencies == std::vector<size_t>{ 0 });
+	// Unrelated data
+	assert(systems[3].dependencies.empty());
+	// Writes wait for the earlier reads & writes
+	assert((systems[4].dependencies == std::vector<size_t>{ 0, 1, 2 }));
+	assert(systems[5].dependencies.size() == 5);
+	assert((systems[0].dependents == std::vector<size_t>{ 1, 2, 4, 5 }));
+}
+
+void TestSystemScheduler::TestOrder()
+{
+	std::vector<std::string> order;
+	std::mutex orderMutex;
+	auto record = [&order, &orderMutex](const std::string& name) {
+		return [&order, &orderMutex, name](float) {
+			std::lock_guard<std::mutex> lock(orderMutex);
+			order.push_back(name);
+		};
+	};
+
+	const SystemResourceMask a = SystemResourceBit(TRANSFORM_DATA);
+	const SystemResourceMask b = SystemResourceBit(DEBRIS_DATA);
+
+	SystemScheduler scheduler;
+	scheduler.AddSystem("first", record("first"), ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+	scheduler.AddSystem("writeA", record("writeA"), 0, a, false);
+	scheduler.AddSystem("writeB", record("writeB"), 0, b, false);
+	scheduler.AddSystem("readA", record("readA"), a, 0, true);
+	scheduler.AddSystem("last", record("last"), ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+	scheduler.Run(16.0f);
+
+	auto position = [&order](const std::string& name) {
+		return std::find(order.begin(), order.end(), name) - order.begin();
+	};
+	assert(order.size() == 5);
+	assert(order.front() == "first" && order.back() == "last");
+	assert(position("writeA") < position("readA"));
+}
+
+void TestSystemScheduler::TestRepeatedRuns()
+{
+	std::atomic<int> runs{ 0 };
+	float lastDeltaTime = 0.0f;
+
+	SystemScheduler scheduler;
+	for (int i = 0; i < 4; i++)
+	{
+		scheduler.AddSystem("parallel", [&runs](float) { runs.fetch_add(1); }, 0, SystemResourceBit(PARTICLE_DATA) << i, false);
+	}
+	scheduler.AddSystem("main", [&lastDeltaTime](float deltaTime) { lastDeltaTime = deltaTime; }, ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+
+	for (int frame = 0; frame < 10; frame++)
+	{
+		scheduler.Run(static_cast<float>(frame));
+		// Every system ran exactly once in the frame
+		assert(runs.load() == 4 * (frame + 1));
+		assert(lastDeltaTime == static_cast<float>(frame));
+	}
+	assert(scheduler.GetLastTime(4) >= 0.0f);
+}
+
+void TestSystemScheduler::TestRunsOnWorkers()
+{
+	// Two independent systems which only finish once both have started, i.e. when they run at the same time.
+	// The deadline turns a serial run into a failed assert instead of a hang.
+	std::atomic<int> started{ 0 };
+	std::atomic<size_t> threadIndices[2];
+	std::atomic<bool> mainOnMainThread{ false };
+	auto meet = [&started, &threadIndices](int system) {
+		return [&started, &threadIndices, system](float) {
+			threadIndices[system] = JobSystem::GetThreadIndex();
+			started.fetch_add(1);
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+			while (started.load() < 2 && std::chrono::steady_clock::now() < deadline)
+			{
+				std::this_thread::yield();
+			}
+		};
+	};
+
+	SystemScheduler scheduler;
+	scheduler.AddSystem("meetA", meet(0), 0, SystemResourceBit(PARTICLE_DATA), false);
+	scheduler.AddSystem("meetB", meet(1), 0, SystemResourceBit(DEBRIS_DATA), false);
+	scheduler.AddSystem("main", [&mainOnMainThread](float) { mainOnMainThread = JobSystem::GetThreadIndex() == 0; },
+		ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+	scheduler.Run(16.0f);
+
+	assert(started.load() == 2);
+	assert(threadIndices[0].load() != threadIndices[1].load());
+	assert(mainOnMainThread.load());
+}
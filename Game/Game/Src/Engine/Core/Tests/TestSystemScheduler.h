@@ -0,0 +1,20 @@
+// @file: TestSystemScheduler.h
+//
+// @brief: Header file for TestSystemScheduler class containing unit tests for SystemScheduler class.
+
+#pragma once
+#ifndef _TEST_SYSTEM_SCHEDULER_H_
+#define _TEST_SYSTEM_SCHEDULER_H_
+
+class TestSystemScheduler
+{
+	static void TestDependencies();
+	static void TestOrder();
+	static void TestRepeatedRuns();
+	static void TestRunsOnWorkers();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_SYSTEM_SCHEDULER_H_
@@ -11,3 +11,16 @@ void TestGetHashCode()
 	s1 = "Ubisoft Next";
 	assert(GetHashCode(s1.c_str()) == 4108938811);
 }
+
+void TestHashBytes()
+{
+	// Reference value of FNV-1a
+	assert(HashBytes("a", 1) == 0xE40C292C);
+
+	// Hashing in parts must give the same hash
+	std::string s1 = "UbisoftNext";
+	assert(HashBytes(s1.c_str(), s1.size()) == HashBytes(s1.c_str() + 7, 4, HashBytes(s1.c_str(), 7)));
+
+	float f1 = 1.0f, f2 = -1.0f;
+	assert(HashBytes(&f1, sizeof(float)) != HashBytes(&f2, sizeof(float)));
+}
@@ -5,11 +5,13 @@
 #include "stdafx.h"
 #include "Engine/Core/util.h"
 #include "Engine/Core/Logger.h"
+#include "Engine/Pools/ComponentAllocator.h"
 
 // All components used in the game
 #include "Engine/Components/MeshRenderer.h"
 #include "Engine/Components/Sprite.h"
 #include "Engine/Components/BoxCollider.h"
+#include "Engine/Components/TriggerCollider.h"
 #include "Engine/Components/RigidBody.h"
 #include "Engine/Components/Particles.h"
 #include "Engine/Components/Canvas.h"
@@ -37,6 +39,20 @@ STRCODE GetHashCode(const char* str)
 	return hash;
 }
 
+STRCODE HashBytes(const void* data, size_t size, STRCODE hash)
+{
+	const unsigned int fnv_prime = 0x01000193;
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= fnv_prime;
+	}
+
+	return hash;
+}
+
 void CreateUUID(UUID* uid)
 {
 	UuidCreate(uid);
@@ -60,9 +76,19 @@ STRCODE GUIDToSTRCODE(UUID& guid)
 	return GetHashCode(GUIDTostring(guid).c_str());
 }
 
-Component* CreateComponent(ComponentType componentType)
+// Construct the component in the given memory
+template <typename T>
+static Component* NewComponent(void* memory)
+{
+	return new (memory) T();
+}
+
+Component* CreateComponent(ComponentType componentType, void* memory)
 {
 	Component* component = nullptr;
+	// Components outside of entity pools come from the slab allocator of their type
+	if (memory == nullptr && ComponentTypeSize(componentType) > 0)
+		memory = ComponentAllocator::Get().Allocate(componentType);
 
 	switch (componentType)
 	{
@@ -71,47 +97,50 @@ Component* CreateComponent(ComponentType componentType)
 		Logger::Get().Log("Trying to create a Transform on an entity. All entities have transform by default.", ERROR_LOG);
 		break;
 	case MeshRendererC:
-		component = new MeshRenderer();
+		component = NewComponent<MeshRenderer>(memory);
 		break;
 	case SpriteC:
-		component = new Sprite();
+		component = NewComponent<Sprite>(memory);
 		break;
 	case BoxColliderC:
-		component = new BoxCollider();
+		component = NewComponent<BoxCollider>(memory);
+		break;
+	case TriggerColliderC:
+		component = NewComponent<TriggerCollider>(memory);
 		break;
 	case RigidBodyC:
-		component = new RigidBody();
+		component = NewComponent<RigidBody>(memory);
 		break;
 	case ParticlesC:
-		component = new Particles();
+		component = NewComponent<Particles>(memory);
 		break;
 	case CanvasC:
-		component = new Canvas();
+		component = NewComponent<Canvas>(memory);
 		break;
 	// Game Components
 	case BallSpawnerC:
-		component = new BallSpawner();
+		component = NewComponent<BallSpawner>(memory);
 		break;
 	case BallC:
-		component = new Ball();
+		component = NewComponent<Ball>(memory);
 		break;
 	case BreakableC:
-		component = new Breakable();
+		component = NewComponent<Breakable>(memory);
 		break;
 	case SelfDestructC:
-		component = new SelfDestruct();
+		component = NewComponent<SelfDestruct>(memory);
 		break;
 	case LevelGeneratorC:
-		component = new LevelGenerator();
+		component = NewComponent<LevelGenerator>(memory);
 		break;
 	case UIManagerC:
-		component = new UIManager();
+		component = NewComponent<UIManager>(memory);
 		break;
 	case DoorOpenerC:
-		component = new DoorOpener();
+		component = NewComponent<DoorOpener>(memory);
 		break;
 	case StarsControllerC:
-		component = new StarsController();
+		component = NewComponent<StarsController>(memory);
 		break;
 	default:
 		Logger::Get().Log("Trying to create an invalid component on an entity.", ERROR_LOG);
@@ -119,6 +148,68 @@ Component* CreateComponent(ComponentType componentType)
 	return component;
 }
 
+size_t ComponentTypeSize(ComponentType componentType)
+{
+	size_t size = 0;
+
+	switch (componentType)
+	{
+	// Engine Components
+	case TransformC:
+		// Part of the entity
+		break;
+	case MeshRendererC:
+		size = sizeof(MeshRenderer);
+		break;
+	case SpriteC:
+		size = sizeof(Sprite);
+		break;
+	case BoxColliderC:
+		size = sizeof(BoxCollider);
+		break;
+	case TriggerColliderC:
+		size = sizeof(TriggerCollider);
+		break;
+	case RigidBodyC:
+		size = sizeof(RigidBody);
+		break;
+	case ParticlesC:
+		size = sizeof(Particles);
+		break;
+	case CanvasC:
+		size = sizeof(Canvas);
+		break;
+	// Game Components
+	case BallSpawnerC:
+		size = sizeof(BallSpawner);
+		break;
+	case BallC:
+		size = sizeof(Ball);
+		break;
+	case BreakableC:
+		size = sizeof(Breakable);
+		break;
+	case SelfDestructC:
+		size = sizeof(SelfDestruct);
+		break;
+	case LevelGeneratorC:
+		size = sizeof(LevelGenerator);
+		break;
+	case UIManagerC:
+		size = sizeof(UIManager);
+		break;
+	case DoorOpenerC:
+		size = sizeof(DoorOpener);
+		break;
+	case StarsControllerC:
+		size = sizeof(StarsController);
+		break;
+	default:
+		Logger::Get().Log("Trying to get the size of an invalid component.", ERROR_LOG);
+	}
+	return size;
+}
+
 std::string ComponentTypeToStr(ComponentType componentType)
 {
 	std::string componentName = "";
@@ -138,6 +229,9 @@ std::string ComponentTypeToStr(ComponentType componentType)
 	case BoxColliderC:
 		componentName = "BoxCollider";
 		break;
+	case TriggerColliderC:
+		componentName = "TriggerCollider";
+		break;
 	case RigidBodyC:
 		componentName = "RigidBody";
 		break;
@@ -178,3 +272,13 @@ std::string ComponentTypeToStr(ComponentType componentType)
 
 	return componentName;
 }
+
+ComponentType StrToComponentType(const std::string& componentName)
+{
+	for (int type = UNDEFINEDC + 1; type < COMPONENT_TYPE_COUNT; type++)
+	{
+		if (ComponentTypeToStr(static_cast<ComponentType>(type)) == componentName)
+			return static_cast<ComponentType>(type);
+	}
+	return UNDEFINEDC;
+}
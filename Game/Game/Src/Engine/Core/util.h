@@ -36,6 +36,16 @@ private:\
  */
 STRCODE GetHashCode(const char* str);
 
+/**
+ * @brief Continue a FNV-1a hash with the given bytes. Used for hashing the game state.
+ *
+ * @param data Bytes to be hashed.
+ * @param size Number of bytes.
+ * @param hash Hash of the data before these bytes. Default is the FNV offset basis.
+ * @return an unsigned integer.
+ */
+STRCODE HashBytes(const void* data, size_t size, STRCODE hash = 0x811C9DC5);
+
 /*
  * @brief Generate a UUID using UuidCreate.
  * 
@@ -64,9 +74,19 @@ STRCODE GUIDToSTRCODE(UUID& guid);
  * @brief Create a component given the component type.
  *
  * @param componentType ComponentType enum
+ * @param memory If not null, the component is constructed here instead of in the ComponentAllocator.
+ * Must have ComponentTypeSize(componentType) bytes.
  * @return Component pointer
  */
-Component* CreateComponent(ComponentType);
+Component* CreateComponent(ComponentType, void* memory = nullptr);
+
+/*
+ * @brief Get the size of the class of a component type.
+ *
+ * @param componentType ComponentType enum
+ * @return Size in bytes, 0 for Transform & invalid types
+ */
+size_t ComponentTypeSize(ComponentType);
 
 /*
  * @brief Convert component type value to a string value.
@@ -76,4 +96,11 @@ Component* CreateComponent(ComponentType);
  */
 std::string ComponentTypeToStr(ComponentType);
 
+/*
+ * @brief Get the component type of a name given by ComponentTypeToStr.
+ *
+ * @return UNDEFINEDC if there's no such component type
+ */
+ComponentType StrToComponentType(const std::string& componentName);
+
 #endif // !_UTIL_H_
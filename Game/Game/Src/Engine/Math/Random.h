@@ -24,6 +24,13 @@ public:
 		return instance;
 	}
 
+	// Same seed gives the same sequence of numbers. Used for deterministic runs.
+	void Seed(unsigned int seed)
+	{
+		generator.seed(seed);
+		distribution.reset();
+	}
+
 	// Returns a floating point number between [0, 1].
 	float Float()
 	{
@@ -10,6 +10,7 @@
 void TestRandom::RunTests()
 {
 	TestFloat();
+	TestSeed();
 	Logger::Get().Log("[UNITTEST] Random - All tests passed!");
 }
 
@@ -19,3 +20,17 @@ void TestRandom::TestFloat()
 	float num2 = Random::Get().Float();
 	assert(num1 != num2);
 }
+
+void TestRandom::TestSeed()
+{
+	Random::Get().Seed(42);
+	float num1 = Random::Get().Float();
+	float num2 = Random::Get().Float();
+
+	Random::Get().Seed(42);
+	assert(Random::Get().Float() == num1);
+	assert(Random::Get().Float() == num2);
+
+	// Game must not get the same numbers on every run
+	Random::Get().Seed(std::random_device{}());
+}
@@ -12,6 +12,7 @@ public:
 	static void RunTests();
 
 	static void TestFloat();
+	static void TestSeed();
 };
 
 #endif // !_TEST_RANDOM_H_
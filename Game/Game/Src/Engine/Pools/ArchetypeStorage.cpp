@@ -0,0 +1,68 @@
+// @file: ArchetypeStorage.cpp
+//
+// @brief: Cpp file for ArchetypeStorage, the chunked memory of the entities of an archetype & their components.
+
+#include "stdafx.h"
+#include "Engine/Pools/ArchetypeStorage.h"
+
+size_t ArchetypeStorage::AlignUp(size_t value)
+{
+	return (value + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+}
+
+ArchetypeStorage::ArchetypeStorage(size_t entitySize, const std::vector<ComponentType>& componentTypes)
+{
+	entityStride = entitySize;
+	size_t rowSize = entityStride;
+	for (ComponentType componentType : componentTypes)
+	{
+		if (componentType == TransformC)
+			continue;
+
+		Column column;
+		column.type = componentType;
+		column.stride = ComponentTypeSize(componentType);
+		columns.push_back(column);
+		rowSize += column.stride;
+	}
+
+	// Big archetypes get at least 1 entity per chunk
+	rowsPerChunk = std::max<size_t>(1, CHUNK_SIZE / rowSize);
+
+	size_t offset = AlignUp(rowsPerChunk * entityStride);
+	for (Column& column : columns)
+	{
+		column.offset = offset;
+		offset = AlignUp(offset + rowsPerChunk * column.stride);
+	}
+	chunkBytes = offset;
+}
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+	for (char* chunk : chunks)
+	{
+		::operator delete(chunk);
+	}
+	chunks.clear();
+}
+
+size_t ArchetypeStorage::AddRow()
+{
+	if (rowCount == chunks.size() * rowsPerChunk)
+		chunks.push_back(static_cast<char*>(::operator new(chunkBytes)));
+	return rowCount++;
+}
+
+void* ArchetypeStorage::GetEntityMemory(size_t row) const
+{
+	assert(row < rowCount);
+	return chunks[row / rowsPerChunk] + (row % rowsPerChunk) * entityStride;
+}
+
+void* ArchetypeStorage::GetComponentMemory(size_t row, size_t column) const
+{
+	assert(row < rowCount && column < columns.size());
+	const Column& c = columns[column];
+	return chunks[row / rowsPerChunk] + c.offset + (row % rowsPerChunk) * c.stride;
+}
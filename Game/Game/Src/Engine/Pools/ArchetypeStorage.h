@@ -0,0 +1,78 @@
+// @file: ArchetypeStorage.h
+//
+// @brief: Header file for ArchetypeStorage, the chunked memory of the entities of an archetype & their components.
+
+#pragma once
+#ifndef _ARCHETYPE_STORAGE_H_
+#define _ARCHETYPE_STORAGE_H_
+
+#include "Engine/Components/Component.h"
+
+/**
+ * @class ArchetypeStorage
+ *
+ * Memory for the entities of one archetype (a set of component types), split into fixed-size chunks.
+ * Each entity is a row. Inside a chunk, each column (the entities, then each component type) is a
+ * contiguous array, so going over one component type of many entities streams through memory.
+ *
+ * Only the memory is managed here. Objects are constructed in their rows & destroyed by the owner (EntityPool).
+ * Rows are never moved or given back, so pointers to them stay valid till the storage is destroyed.
+ */
+class ArchetypeStorage
+{
+	friend class TestArchetypeStorage;
+
+	static const size_t CHUNK_SIZE = 16 * 1024;
+	// Alignment of new (& of the chunks). No component asks for more, so columns start at multiples of it.
+	static const size_t COLUMN_ALIGNMENT = 16;
+
+	struct Column
+	{
+		ComponentType type = UNDEFINEDC;
+		// Size of an item
+		size_t stride = 0;
+		// From the start of a chunk
+		size_t offset = 0;
+	};
+	std::vector<Column> columns;
+	// Entities are the first column
+	size_t entityStride = 0;
+
+	size_t rowsPerChunk = 0;
+	size_t chunkBytes = 0;
+	std::vector<char*> chunks;
+	size_t rowCount = 0;
+
+	static size_t AlignUp(size_t value);
+
+	inline explicit ArchetypeStorage(ArchetypeStorage const&) = delete;
+	inline ArchetypeStorage& operator=(ArchetypeStorage const&) = delete;
+
+public:
+	/**
+	 * @param entitySize Size of an entity (sizeof(Entity))
+	 * @param componentTypes Component types of the archetype. Transform is skipped as it's part of the entity.
+	 */
+	ArchetypeStorage(size_t entitySize, const std::vector<ComponentType>& componentTypes);
+	~ArchetypeStorage();
+
+	/**
+	 * @brief Reserve memory for another entity & its components.
+	 * @return Row of the entity
+	 */
+	size_t AddRow();
+
+	void* GetEntityMemory(size_t row) const;
+	/**
+	 * @brief Get the memory of a component of a row.
+	 * @param column Index of the component type (as passed to the constructor, without Transform)
+	 */
+	void* GetComponentMemory(size_t row, size_t column) const;
+
+	size_t GetRowCount() const { return rowCount; }
+	size_t GetRowsPerChunk() const { return rowsPerChunk; }
+	size_t GetColumnCount() const { return columns.size(); }
+	ComponentType GetColumnType(size_t column) const { return columns[column].type; }
+};
+
+#endif // !_ARCHETYPE_STORAGE_H_
@@ -0,0 +1,67 @@
+// @file: ComponentAllocator.cpp
+//
+// @brief: Cpp file for SlabAllocator & ComponentAllocator, which keep components of the same type next to each other.
+
+#include "stdafx.h"
+#include "Engine/Pools/ComponentAllocator.h"
+
+// --------------------------- SlabAllocator ---------------------------
+
+SlabAllocator::SlabAllocator(size_t size)
+{
+	// Free slots must be able to hold the free list pointer
+	slotSize = std::max(size, sizeof(void*));
+	slotSize = (slotSize + SLOT_ALIGNMENT - 1) & ~(SLOT_ALIGNMENT - 1);
+	slotsPerSlab = std::max<size_t>(1, SLAB_SIZE / slotSize);
+}
+
+void* SlabAllocator::Allocate()
+{
+	if (freeList == nullptr)
+	{
+		// Slots of a new slab are put on the free list in order, so they get handed out front to back
+		char* slab = new char[slotsPerSlab * slotSize];
+		slabs.emplace_back(slab);
+		for (size_t i = slotsPerSlab; i > 0; i--)
+		{
+			void* slot = slab + (i - 1) * slotSize;
+			*static_cast<void**>(slot) = freeList;
+			freeList = slot;
+		}
+	}
+
+	void* slot = freeList;
+	freeList = *static_cast<void**>(slot);
+	usedSlots++;
+	return slot;
+}
+
+void SlabAllocator::Free(void* slot)
+{
+	assert(usedSlots > 0);
+	*static_cast<void**>(slot) = freeList;
+	freeList = slot;
+	usedSlots--;
+}
+
+// --------------------------- ComponentAllocator ---------------------------
+
+void* ComponentAllocator::Allocate(ComponentType componentType)
+{
+	if (allocators[componentType] == nullptr)
+		allocators[componentType].reset(new SlabAllocator(ComponentTypeSize(componentType)));
+	return allocators[componentType]->Allocate();
+}
+
+void ComponentAllocator::Free(ComponentType componentType, void* memory)
+{
+	assert(allocators[componentType] != nullptr);
+	allocators[componentType]->Free(memory);
+}
+
+size_t ComponentAllocator::GetUsedSlots(ComponentType componentType) const
+{
+	if (allocators[componentType] == nullptr)
+		return 0;
+	return allocators[componentType]->GetUsedSlots();
+}
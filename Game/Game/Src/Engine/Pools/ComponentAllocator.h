@@ -0,0 +1,76 @@
+// @file: ComponentAllocator.h
+//
+// @brief: Header file for SlabAllocator & ComponentAllocator, which keep components of the same type next to each other.
+
+#pragma once
+#ifndef _COMPONENT_ALLOCATOR_H_
+#define _COMPONENT_ALLOCATOR_H_
+
+#include "Engine/Core/util.h"
+#include "Engine/Components/Component.h"
+
+/**
+ * @class SlabAllocator
+ *
+ * Hands out fixed-size slots from big blocks (slabs). Freed slots go on a free list & are handed out again
+ * before a new slab is allocated, so once the game warmed up it stops touching the heap.
+ * The free list is kept inside the freed slots themselves.
+ */
+class SlabAllocator
+{
+	friend class TestComponentAllocator;
+
+	static const size_t SLAB_SIZE = 16 * 1024;
+	// Alignment of new, so every slot of a slab is aligned like a separate allocation
+	static const size_t SLOT_ALIGNMENT = 16;
+
+	size_t slotSize = 0;
+	size_t slotsPerSlab = 0;
+	std::vector<std::unique_ptr<char[]>> slabs;
+	// Last freed slot. Each free slot starts with a pointer to the next one.
+	void* freeList = nullptr;
+	size_t usedSlots = 0;
+
+	inline explicit SlabAllocator(SlabAllocator const&) = delete;
+	inline SlabAllocator& operator=(SlabAllocator const&) = delete;
+
+public:
+	explicit SlabAllocator(size_t size);
+
+	void* Allocate();
+	void Free(void* slot);
+
+	size_t GetSlotSize() const { return slotSize; }
+	size_t GetUsedSlots() const { return usedSlots; }
+	size_t GetCapacity() const { return slabs.size() * slotsPerSlab; }
+};
+
+/**
+ * @class ComponentAllocator
+ *
+ * Memory of components created outside of an EntityPool (those live in the archetype chunks of their pool).
+ * There's a slab allocator for each component type, so components of the same type sit next to each other.
+ * Use CreateComponent & Component::Free instead of calling it directly.
+ */
+class ComponentAllocator
+{
+	DECLARE_SINGLETON(ComponentAllocator)
+
+	// Created on first use, as most component types only ever live in entity pools
+	std::unique_ptr<SlabAllocator> allocators[COMPONENT_TYPE_COUNT];
+
+public:
+	/**
+	 * @brief Get memory for a component of the type. It isn't constructed.
+	 */
+	void* Allocate(ComponentType componentType);
+	/**
+	 * @brief Give back the memory of a component. It must be destroyed already.
+	 */
+	void Free(ComponentType componentType, void* memory);
+
+	// Number of components of the type currently allocated
+	size_t GetUsedSlots(ComponentType componentType) const;
+};
+
+#endif // !_COMPONENT_ALLOCATOR_H_
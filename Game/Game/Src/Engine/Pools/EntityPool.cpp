@@ -18,39 +18,37 @@
 #include "Engine/Systems/CollisionSystem.h"
 #include "Engine/Systems/PhysicsSystem.h"
 
-EntityPool::EntityPool(std::vector<ComponentType>& components, int _poolSize)
+EntityPool::EntityPool(std::vector<ComponentType>& components, int _poolSize) :
+	componentTypes(components), storage(sizeof(Entity), components)
 {
-	componentTypes = components;
 	poolSize = _poolSize;
-	for (size_t i = 0; i < poolSize; i++)
+	for (ComponentType componentType : componentTypes)
 	{
-		Object* object = CreateObjectForPool();
-		objects.push_back(object);
-
-		// All are free in the beginning
-		availableIndices.push(i);
-
-		// Populate map
-		objectPtrToIndex[object] = i;
+		poolName += (poolName.empty() ? "" : " ") + ComponentTypeToStr(componentType);
 	}
+	// All are free in the beginning
+	AddObjects(poolSize);
 }
 
 EntityPool::~EntityPool()
 {
+	// Memory belongs to the storage, so the entities are only destroyed
 	for (Object* object : objects)
 	{
 		object->Destroy();
-		delete object;
+		object->~Object();
 	}
 	objects.clear();
 }
 
 Object* EntityPool::CreateObjectForPool()
 {
-	Object* obj = new Entity();
-	// SetupObject must be called right after creating the entity for most cache coherence.
-	SetupObject(obj);
-	return obj;
+	size_t row = storage.AddRow();
+	Entity* entity = new (storage.GetEntityMemory(row)) Entity();
+	entity->poolRow = row;
+	// Components go in the same row
+	SetupObject(entity);
+	return entity;
 }
 
 void EntityPool::SetupObject(Object* object)
@@ -59,6 +57,8 @@ void EntityPool::SetupObject(Object* object)
 		return;
 
 	Entity* entity = static_cast<Entity*>(object);
+	// Column of the storage for the next component
+	size_t column = 0;
 	for (ComponentType componentType : componentTypes)
 	{
 		// "Transform" component is not created dynamically. It is part of an Entity.
@@ -67,13 +67,14 @@ void EntityPool::SetupObject(Object* object)
 		if (componentType == TransformC)
 			continue;
 
-		Component* component = CreateComponent(componentType);
+		Component* component = CreateComponent(componentType, storage.GetComponentMemory(entity->poolRow, column++));
 		if (component == nullptr)
 		{
 			Logger::Get().Log("Entity pool tried to create null component in entity " + entity->GetName());
 			continue;
 		}
-		entity->componentsToAdd.push_back(component);
+		component->isChunkAllocated = true;
+		entity->TrackComponent(component);
 
 		// All components must know about their entity
 		component->entity = entity;
@@ -89,12 +90,9 @@ void EntityPool::CleanUpObject(Object* object)
 
 	Entity* entity = static_cast<Entity*>(object);
 
-	// Remove it from the scene
-	Scene* scene = SceneManager::Get().GetActiveScene();
-	if (scene == nullptr)
-		return;
-
-	scene->UntrackEntity(entity);
+	// Remove it from its scene. Dangling entities aren't in one, but their components are still in the systems.
+	if (entity->scene != nullptr)
+		entity->scene->UntrackEntity(entity);
 
 	// Remove renderable components from RenderSystem
 	for (ComponentType& componentType : renderables)
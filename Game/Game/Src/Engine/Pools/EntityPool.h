@@ -7,6 +7,7 @@
 #define _ENTITY_POOL_H_
 
 #include "Engine/Pools/ObjectPool.h"
+#include "Engine/Pools/ArchetypeStorage.h"
 #include "Engine/Components/Component.h"
 
 class Entity;
@@ -18,8 +19,9 @@ class Entity;
  * 
  * It creates components of each entity with it for best cache coherence.
  * All the components of all entities in a scene get updated in one game loop.
- * Having these components tightly packed together in memory with the entity is essential for best performance.
- * This class ensures it.
+ * Having these components tightly packed together in memory is essential for best performance.
+ * Entities & their components are constructed in the chunks of an ArchetypeStorage, so the entities of a pool
+ * are next to each other & so are all their components of the same type.
  * 
  * There is a different EntityPool instance in SceneManager for each archetype of entity.
  * An archetype describes a type of entity, i.e. an entity having a particular type of components.
@@ -31,9 +33,11 @@ private:
 	// present in this entity pool.
 	// Component creation happens with new entity creation. Improves cache coherence.
 	std::vector<ComponentType> componentTypes;
+	// Memory of the entities & their components
+	ArchetypeStorage storage;
 
-	std::vector<ComponentType> renderables{ MeshRendererC, SpriteC, BoxColliderC, ParticlesC, CanvasC, UIManagerC };
-	std::vector<ComponentType> colliders{ BoxColliderC };
+	std::vector<ComponentType> renderables{ MeshRendererC, SpriteC, BoxColliderC, TriggerColliderC, ParticlesC, CanvasC, UIManagerC };
+	std::vector<ComponentType> colliders{ BoxColliderC, TriggerColliderC };
 
 	void CleanUpObject(Object*) override;
 	void InitializeObject(Object*) override;
@@ -50,6 +54,8 @@ public:
 	EntityPool(std::vector<ComponentType>&, int _poolSize = 10);
 	~EntityPool();
 
+	const std::vector<ComponentType>& GetComponentTypes() const { return componentTypes; }
+
 	friend class Engine;
 };
 
@@ -6,32 +6,54 @@
 
 #include "Engine/Pools/ObjectPool.h"
 #include "Engine/Core/Object.h"
+#include "Engine/Core/Logger.h"
 #include "Engine/Systems/SceneManager.h"
 #include "Engine/Systems/Scene.h"
 
-Object* ObjectPool::GetFreeObject()
+void ObjectPool::AddObjects(size_t count)
 {
-	if (availableIndices.empty())
+	size_t firstIndex = objects.size();
+	objects.reserve(firstIndex + count);
+	freeIndices.reserve(firstIndex + count);
+	for (size_t idx = firstIndex; idx < firstIndex + count; idx++)
+	{
+		Object* object = CreateObjectForPool();
+		object->poolIndex = idx;
+		object->isFreeInPool = true;
+		objects.push_back(object);
+	}
+
+	// Lowest index on top, so new objects are handed out in memory order
+	for (size_t idx = firstIndex + count; idx > firstIndex; idx--)
 	{
-		// Increase pool size
-		int t = poolIncrementSize;
-		size_t idx = objects.size();
-		while (t)
-		{
-			Object* object = CreateObjectForPool();
-			objects.push_back(object);
-
-			availableIndices.push(idx);
-			objectPtrToIndex[object] = idx;
-
-			--t; ++idx;
-		}
+		freeIndices.push_back(idx - 1);
 	}
+}
+
+void ObjectPool::EnsureFreeObjects(size_t count)
+{
+	if (freeIndices.size() >= count)
+		return;
 
-	size_t freeIndex = availableIndices.top();
-	availableIndices.pop();
+	// Increase pool size. Doubling keeps the number of batches small when the game needs a lot of objects.
+	size_t growBy = std::max(objects.size(), static_cast<size_t>(poolIncrementSize));
+	growBy = std::max(growBy, count - freeIndices.size());
+
+	// Pool was too small for the game. Shows up in the suggested pool config.
+	growthCount++;
+	Logger::Get().Log("Pool " + poolName + " ran out of objects, growing from " + std::to_string(objects.size()) +
+		" to " + std::to_string(objects.size() + growBy), WARNING_LOG);
+	AddObjects(growBy);
+}
+
+Object* ObjectPool::TakeFreeObject()
+{
+	size_t freeIndex = freeIndices.back();
+	freeIndices.pop_back();
 
 	Object* object = objects[freeIndex];
+	object->isFreeInPool = false;
+	highWaterMark = std::max(highWaterMark, GetUsedObjectCount());
 	object->SetActive(true);  // Not really required, but why not
 
 	InitializeObject(object);
@@ -39,14 +61,49 @@ Object* ObjectPool::GetFreeObject()
 	return object;
 }
 
+Object* ObjectPool::GetFreeObject()
+{
+	EnsureFreeObjects(1);
+	return TakeFreeObject();
+}
+
+void ObjectPool::GetFreeObjects(size_t count, std::vector<Object*>& result)
+{
+	EnsureFreeObjects(count);
+	result.reserve(result.size() + count);
+	for (size_t i = 0; i < count; i++)
+	{
+		result.push_back(TakeFreeObject());
+	}
+}
+
 void ObjectPool::MarkObjectAsFree(Object* object)
 {
-	if (objectPtrToIndex.find(object) == objectPtrToIndex.end())
+	if (object->poolIndex >= objects.size() || objects[object->poolIndex] != object)
+	{
+		return;
+	}
+	if (object->isFreeInPool)
 	{
 		return;
 	}
 
 	CleanUpObject(object);
 
-	availableIndices.push(objectPtrToIndex[object]);
+	object->isFreeInPool = true;
+	freeIndices.push_back(object->poolIndex);
+}
+
+void ObjectPool::Prewarm(size_t count)
+{
+	if (objects.size() < count)
+		AddObjects(count - objects.size());
+}
+
+void ObjectPool::MarkObjectsAsFree(const std::vector<Object*>& freedObjects)
+{
+	for (Object* object : freedObjects)
+	{
+		MarkObjectAsFree(object);
+	}
 }
@@ -17,18 +17,35 @@ class ObjectPool
 {
 protected:
 	int poolSize = 10;
-	// If all objects in pool gets used up, its size gets increased by this amount
+	// If all objects in pool gets used up, its size gets doubled, but it grows by at least this amount
 	int poolIncrementSize = 5;
 
 	// Using vector due to O(1) access time
+	// Every object knows its index in here (Object::poolIndex), for O(1) freeing time
 	std::vector<Object*> objects;
 
-	// Storing free object indices in a stack
-	// Using stack instead of queue for less cache miss
-	std::stack<size_t> availableIndices;
+	// Indices of the free objects, used as a stack (last freed is handed out first, it's likely still in cache)
+	std::vector<size_t> freeIndices;
 
-	// For O(1) freeing time
-	std::map<Object*, size_t> objectPtrToIndex;
+	// Usage telemetry, used to size the pools up front (see SceneManager::SavePoolConfig)
+	std::string poolName = "";
+	// Most objects in use at once
+	size_t highWaterMark = 0;
+	// Number of times the pool ran out of objects & had to grow
+	size_t growthCount = 0;
+
+	/**
+	 * @brief Create more objects for the pool. They are all free.
+	 */
+	void AddObjects(size_t count);
+	/**
+	 * @brief Grow the pool so that at least the given number of objects are free.
+	 */
+	void EnsureFreeObjects(size_t count);
+	/**
+	 * @brief Take a free object out of the pool. There must be one.
+	 */
+	Object* TakeFreeObject();
 
 	// Clean-up involves anything to-be-done before returning an object
 	// to the pool or deleting it (at game quit)
@@ -44,14 +61,38 @@ protected:
 	// method must be called as less as possible.
 	// Object allocation initially happens at start of the game. Game developer must
 	// create sufficiently big entity pool at that time. If all objects of the pool get used up,
-	// the pool size gets increased in a batch. These configs are part of ObjectPoolConfig.json
+	// the pool size gets increased in a batch. Entity pool sizes are part of ObjectPoolConfig.txt
 	virtual Object* CreateObjectForPool() = 0;
 
 public:
 	ObjectPool() = default;
 
 	Object* GetFreeObject();
+	/**
+	 * @brief Get several free objects at once. The pool grows at most once for all of them.
+	 *
+	 * @param count Number of objects
+	 * @param result The objects are appended to it
+	 */
+	void GetFreeObjects(size_t count, std::vector<Object*>& result);
+
+	/**
+	 * @brief Return an object to the pool. Objects which are not from this pool or are free already are ignored.
+	 */
 	void MarkObjectAsFree(Object*);
+	void MarkObjectsAsFree(const std::vector<Object*>& freedObjects);
+
+	/**
+	 * @brief Create objects up front, so that the pool has at least the given number. It isn't counted as growth.
+	 */
+	void Prewarm(size_t count);
+
+	const std::string& GetName() const { return poolName; }
+	size_t GetObjectCount() const { return objects.size(); }
+	size_t GetFreeObjectCount() const { return freeIndices.size(); }
+	size_t GetUsedObjectCount() const { return objects.size() - freeIndices.size(); }
+	size_t GetHighWaterMark() const { return highWaterMark; }
+	size_t GetGrowthCount() const { return growthCount; }
 };
 
 #endif // !_OBJECT_POOL_H_
@@ -0,0 +1,77 @@
+// @file: TestArchetypeStorage.cpp
+//
+// @brief: Cpp file for TestArchetypeStorage class containing unit tests for ArchetypeStorage class.
+
+#include "stdafx.h"
+#include "TestArchetypeStorage.h"
+#include "Engine/Pools/ArchetypeStorage.h"
+#include "Engine/Components/BoxCollider.h"
+#include "Engine/Core/Logger.h"
+
+void TestArchetypeStorage::RunTests()
+{
+	TestLayout();
+	TestAddRow();
+	TestConstructInPlace();
+	Logger::Get().Log("[UNITTEST] ArchetypeStorage - All tests passed!");
+}
+
+void TestArchetypeStorage::TestLayout()
+{
+	std::vector<ComponentType> types{ TransformC, BoxColliderC, RigidBodyC };
+	ArchetypeStorage storage(100, types);
+
+	// Transform is part of the entity
+	assert(storage.GetColumnCount() == 2);
+	assert(storage.GetColumnType(0) == BoxColliderC && storage.GetColumnType(1) == RigidBodyC);
+	assert(storage.GetRowsPerChunk() > 1);
+
+	// Columns are aligned & don't overlap
+	size_t entitiesEnd = storage.GetRowsPerChunk() * 100;
+	for (size_t c = 0; c < storage.columns.size(); c++)
+	{
+		const ArchetypeStorage::Column& column = storage.columns[c];
+		assert(column.stride == ComponentTypeSize(column.type));
+		assert(column.offset % ArchetypeStorage::COLUMN_ALIGNMENT == 0);
+		assert(column.offset >= entitiesEnd);
+		if (c > 0)
+			assert(column.offset >= storage.columns[c - 1].offset + storage.GetRowsPerChunk() * storage.columns[c - 1].stride);
+	}
+	const ArchetypeStorage::Column& last = storage.columns.back();
+	assert(storage.chunkBytes >= last.offset + storage.GetRowsPerChunk() * last.stride);
+}
+
+void TestArchetypeStorage::TestAddRow()
+{
+	std::vector<ComponentType> types{ BoxColliderC };
+	ArchetypeStorage storage(64, types);
+	assert(storage.chunks.empty());
+
+	size_t rows = storage.GetRowsPerChunk() + 1;
+	for (size_t row = 0; row < rows; row++)
+		assert(storage.AddRow() == row);
+	assert(storage.GetRowCount() == rows);
+	assert(storage.chunks.size() == 2);
+
+	// Rows of a chunk are next to each other
+	char* first = static_cast<char*>(storage.GetComponentMemory(0, 0));
+	char* second = static_cast<char*>(storage.GetComponentMemory(1, 0));
+	assert(second - first == static_cast<ptrdiff_t>(ComponentTypeSize(BoxColliderC)));
+	assert(static_cast<char*>(storage.GetEntityMemory(1)) - static_cast<char*>(storage.GetEntityMemory(0)) == 64);
+
+	// Last row starts the second chunk
+	assert(storage.GetEntityMemory(rows - 1) == storage.chunks[1]);
+}
+
+void TestArchetypeStorage::TestConstructInPlace()
+{
+	std::vector<ComponentType> types{ BoxColliderC };
+	ArchetypeStorage storage(64, types);
+	size_t row = storage.AddRow();
+
+	void* memory = storage.GetComponentMemory(row, 0);
+	Component* component = CreateComponent(BoxColliderC, memory);
+	assert(component == memory);
+	assert(static_cast<BoxCollider*>(component)->GetColliderType() == BOX);
+	component->~Component();
+}
@@ -0,0 +1,19 @@
+// @file: TestArchetypeStorage.h
+//
+// @brief: Header file for TestArchetypeStorage class containing unit tests for ArchetypeStorage class.
+
+#pragma once
+#ifndef _TEST_ARCHETYPE_STORAGE_H_
+#define _TEST_ARCHETYPE_STORAGE_H_
+
+class TestArchetypeStorage
+{
+	static void TestLayout();
+	static void TestAddRow();
+	static void TestConstructInPlace();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_ARCHETYPE_STORAGE_H_
@@ -0,0 +1,113 @@
+// @file: TestComponentAllocator.cpp
+//
+// @brief: Cpp file for TestComponentAllocator class containing unit tests for SlabAllocator & ComponentAllocator classes.
+
+#include "stdafx.h"
+#include "TestComponentAllocator.h"
+#include "Engine/Pools/ComponentAllocator.h"
+#include "Engine/Components/BoxCollider.h"
+#include "Engine/Components/Particles.h"
+#include "Engine/Core/Logger.h"
+
+void TestComponentAllocator::RunTests()
+{
+	TestSlotLayout();
+	TestReuse();
+	TestGrowth();
+	TestCreateComponent();
+	TestParticleBuffers();
+	Logger::Get().Log("[UNITTEST] ComponentAllocator - All tests passed!");
+}
+
+void TestComponentAllocator::TestSlotLayout()
+{
+	SlabAllocator allocator(40);
+	assert(allocator.GetSlotSize() == 48);
+	assert(allocator.GetCapacity() == 0);
+
+	// Slots of a slab are handed out next to each other
+	char* first = static_cast<char*>(allocator.Allocate());
+	char* second = static_cast<char*>(allocator.Allocate());
+	assert(second - first == 48);
+	assert(reinterpret_cast<uintptr_t>(first) % SlabAllocator::SLOT_ALIGNMENT == 0);
+	assert(allocator.GetUsedSlots() == 2);
+	assert(allocator.GetCapacity() == allocator.slotsPerSlab);
+}
+
+void TestComponentAllocator::TestReuse()
+{
+	SlabAllocator allocator(64);
+	void* first = allocator.Allocate();
+	void* second = allocator.Allocate();
+
+	// Last freed slot is reused first
+	allocator.Free(first);
+	allocator.Free(second);
+	assert(allocator.GetUsedSlots() == 0);
+	assert(allocator.Allocate() == second);
+	assert(allocator.Allocate() == first);
+	assert(allocator.GetCapacity() == allocator.slotsPerSlab);
+}
+
+void TestComponentAllocator::TestGrowth()
+{
+	SlabAllocator allocator(1000);
+	size_t count = allocator.slotsPerSlab + 1;
+	std::vector<void*> slots;
+	for (size_t i = 0; i < count; i++)
+		slots.push_back(allocator.Allocate());
+
+	assert(allocator.slabs.size() == 2);
+	assert(allocator.GetUsedSlots() == count);
+	// Last slot starts the second slab
+	assert(slots.back() == allocator.slabs[1].get());
+
+	// All slots are different
+	std::sort(slots.begin(), slots.end());
+	assert(std::adjacent_find(slots.begin(), slots.end()) == slots.end());
+
+	for (void* slot : slots)
+		allocator.Free(slot);
+	assert(allocator.GetUsedSlots() == 0);
+	assert(allocator.slabs.size() == 2);
+}
+
+void TestComponentAllocator::TestCreateComponent()
+{
+	size_t used = ComponentAllocator::Get().GetUsedSlots(BoxColliderC);
+
+	Component* component = CreateComponent(BoxColliderC);
+	assert(static_cast<BoxCollider*>(component)->GetColliderType() == BOX);
+	assert(ComponentAllocator::Get().GetUsedSlots(BoxColliderC) == used + 1);
+
+	Component::Free(component);
+	assert(ComponentAllocator::Get().GetUsedSlots(BoxColliderC) == used);
+
+	// Memory gets reused by the next component of the type
+	Component* next = CreateComponent(BoxColliderC);
+	assert(next == component);
+	Component::Free(next);
+}
+
+void TestComponentAllocator::TestParticleBuffers()
+{
+	SlabAllocator& buffers = Particles::GetParticleBuffers();
+	size_t used = buffers.GetUsedSlots();
+
+	Particles* first = static_cast<Particles*>(CreateComponent(ParticlesC));
+	assert(buffers.GetUsedSlots() == used + 1);
+	first->particlePool[0].isActive = true;
+	first->particlePool[Particles::maxParticles - 1].isActive = true;
+	Particles::Particle* buffer = first->particlePool;
+	size_t capacity = buffers.GetCapacity();
+	Component::Free(first);
+	assert(buffers.GetUsedSlots() == used);
+
+	// The next particle system gets the same buffer without a new allocation, with none of the old particles
+	Particles* second = static_cast<Particles*>(CreateComponent(ParticlesC));
+	assert(second->particlePool == buffer);
+	assert(buffers.GetCapacity() == capacity);
+	for (size_t i = 0; i < Particles::maxParticles; i++)
+		assert(!second->particlePool[i].isActive);
+	Component::Free(second);
+}
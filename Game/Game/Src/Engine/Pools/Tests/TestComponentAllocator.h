@@ -0,0 +1,21 @@
+// @file: TestComponentAllocator.h
+//
+// @brief: Header file for TestComponentAllocator class containing unit tests for SlabAllocator & ComponentAllocator classes.
+
+#pragma once
+#ifndef _TEST_COMPONENT_ALLOCATOR_H_
+#define _TEST_COMPONENT_ALLOCATOR_H_
+
+class TestComponentAllocator
+{
+	static void TestSlotLayout();
+	static void TestReuse();
+	static void TestGrowth();
+	static void TestCreateComponent();
+	static void TestParticleBuffers();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_COMPONENT_ALLOCATOR_H_
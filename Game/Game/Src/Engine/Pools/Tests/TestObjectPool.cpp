@@ -0,0 +1,157 @@
+// @file: TestObjectPool.cpp
+//
+// @brief: Cpp file for TestObjectPool class containing unit tests for ObjectPool class.
+
+#include "stdafx.h"
+#include "TestObjectPool.h"
+#include "Engine/Pools/ObjectPool.h"
+#include "Engine/Core/Object.h"
+#include "Engine/Core/Logger.h"
+
+// Plain object & pool, counting what the pool does to them
+class TestPoolObject : public Object
+{
+public:
+	void Initialize() override {}
+	void Destroy() override {}
+};
+
+class TestPool : public ObjectPool
+{
+	void CleanUpObject(Object*) override { cleanUps++; }
+	void InitializeObject(Object*) override {}
+	void SetupObject(Object*) override {}
+	Object* CreateObjectForPool() override { return new TestPoolObject(); }
+
+public:
+	size_t cleanUps = 0;
+
+	TestPool(int size, int incrementSize)
+	{
+		poolSize = size;
+		poolIncrementSize = incrementSize;
+		AddObjects(poolSize);
+	}
+	~TestPool()
+	{
+		for (Object* object : objects)
+			delete object;
+	}
+};
+
+void TestObjectPool::RunTests()
+{
+	TestGetAndFree();
+	TestDoubleFree();
+	TestGrowth();
+	TestBulk();
+	TestTelemetry();
+	Logger::Get().Log("[UNITTEST] ObjectPool - All tests passed!");
+}
+
+void TestObjectPool::TestGetAndFree()
+{
+	TestPool pool(4, 2);
+	assert(pool.GetObjectCount() == 4 && pool.GetFreeObjectCount() == 4);
+
+	Object* first = pool.GetFreeObject();
+	Object* second = pool.GetFreeObject();
+	assert(first != second);
+	assert(pool.GetFreeObjectCount() == 2);
+
+	// Last freed is handed out first
+	pool.MarkObjectAsFree(first);
+	assert(pool.cleanUps == 1);
+	assert(pool.GetFreeObjectCount() == 3);
+	assert(pool.GetFreeObject() == first);
+}
+
+void TestObjectPool::TestDoubleFree()
+{
+	TestPool pool(2, 2);
+	Object* object = pool.GetFreeObject();
+
+	pool.MarkObjectAsFree(object);
+	pool.MarkObjectAsFree(object);
+	assert(pool.cleanUps == 1);
+	assert(pool.GetFreeObjectCount() == 2);
+
+	// Objects of other pools are ignored
+	TestPool otherPool(2, 2);
+	Object* other = otherPool.GetFreeObject();
+	pool.MarkObjectAsFree(other);
+	assert(pool.cleanUps == 1);
+	assert(pool.GetFreeObjectCount() == 2);
+
+	// Both objects are still handed out once each
+	Object* a = pool.GetFreeObject();
+	Object* b = pool.GetFreeObject();
+	assert(a != b);
+	assert(pool.GetFreeObjectCount() == 0);
+}
+
+void TestObjectPool::TestGrowth()
+{
+	TestPool pool(4, 2);
+	for (int i = 0; i < 4; i++)
+		pool.GetFreeObject();
+
+	// Doubles when it runs out
+	pool.GetFreeObject();
+	assert(pool.GetObjectCount() == 8);
+	for (int i = 0; i < 3; i++)
+		pool.GetFreeObject();
+	pool.GetFreeObject();
+	assert(pool.GetObjectCount() == 16);
+
+	// Small pools still grow by the increment size
+	TestPool smallPool(1, 5);
+	smallPool.GetFreeObject();
+	smallPool.GetFreeObject();
+	assert(smallPool.GetObjectCount() == 6);
+}
+
+void TestObjectPool::TestBulk()
+{
+	TestPool pool(4, 2);
+	std::vector<Object*> objects;
+	pool.GetFreeObjects(10, objects);
+	assert(objects.size() == 10);
+	// Grown once, enough for all of them
+	assert(pool.GetObjectCount() == 10);
+	assert(pool.GetFreeObjectCount() == 0);
+
+	std::vector<Object*> sorted = objects;
+	std::sort(sorted.begin(), sorted.end());
+	assert(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+	pool.MarkObjectsAsFree(objects);
+	assert(pool.cleanUps == 10);
+	assert(pool.GetFreeObjectCount() == 10);
+}
+
+void TestObjectPool::TestTelemetry()
+{
+	TestPool pool(2, 2);
+	pool.Prewarm(6);
+	assert(pool.GetObjectCount() == 6 && pool.GetFreeObjectCount() == 6);
+	assert(pool.GetGrowthCount() == 0);
+
+	std::vector<Object*> objects;
+	pool.GetFreeObjects(4, objects);
+	pool.MarkObjectsAsFree(objects);
+	pool.GetFreeObject();
+	// Most in use at once, not currently in use
+	assert(pool.GetHighWaterMark() == 4);
+	assert(pool.GetUsedObjectCount() == 1);
+	assert(pool.GetGrowthCount() == 0);
+
+	objects.clear();
+	pool.GetFreeObjects(6, objects);
+	assert(pool.GetHighWaterMark() == 7);
+	assert(pool.GetGrowthCount() == 1);
+
+	// Smaller prewarm doesn't shrink
+	pool.Prewarm(2);
+	assert(pool.GetObjectCount() == 12);
+}
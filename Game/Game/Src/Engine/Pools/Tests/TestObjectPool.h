@@ -0,0 +1,21 @@
+// @file: TestObjectPool.h
+//
+// @brief: Header file for TestObjectPool class containing unit tests for ObjectPool class.
+
+#pragma once
+#ifndef _TEST_OBJECT_POOL_H_
+#define _TEST_OBJECT_POOL_H_
+
+class TestObjectPool
+{
+	static void TestGetAndFree();
+	static void TestDoubleFree();
+	static void TestGrowth();
+	static void TestBulk();
+	static void TestTelemetry();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_OBJECT_POOL_H_
@@ -8,83 +8,238 @@
 #include "Engine/Components/Entity.h"
 #include "Engine/Components/Collider.h"
 #include "Engine/Components/BoxCollider.h"
+#include "Engine/Components/TriggerCollider.h"
 #include "Engine/Math/Vector3.h"
 #include "Engine/Algorithms/BVH.h"
+#include "Engine/Systems/PhysicsSystem.h"
+#include "Engine/Components/RigidBody.h"
+#include "Engine/Core/JobSystem.h"
 
 void CollisionSystem::Initialize()
 {
-	bvhTree = new BVH();
+	for (BVH*& tree : bvhTrees)
+		tree = new BVH();
+	spareTree = bvhTrees[1];
+	buildTree = bvhTrees[2];
 
 	// CollisionSystem gets initialized after the SceneManager
 	// So we can safely assume that initial colliders are present in the list
-	BuildNewBVHTree();
+	BuildNewBVHTree(bvhTrees[0]);
+	activeTree.store(bvhTrees[0]);
 }
 
 void CollisionSystem::Update()
 {
-	bool updateTree = false;
-	if (!collidersAddedRemoved)
+	// Check if any box colliders got updated. If yes, we need to update the BVH tree.
+	// Removed colliders must leave the active tree too, as a refit reads every collider in it.
+	bool updateTree = collidersRemoved;
+	collidersRemoved = false;
+	for (Collider* collider : colliders)
 	{
-		// Check if any box colliders got updated. If yes, we need to update the BVH tree
-		for (Collider* collider : colliders)
+		if (collider->GetColliderType() == BOX && collider->gotUpdated)
 		{
-			if (collider->GetColliderType() == BOX && collider->gotUpdated)
-			{
-				collider->gotUpdated = false;
-				updateTree = true;
-			}
+			collider->gotUpdated = false;
+			updateTree = true;
 		}
 	}
 
-	// Update BVH Tree
-	if (collidersAddedRemoved || updateTree)
+	if (!isBuilding && (collidersAddedRemoved || (treeUpdateCount >= MAX_TREE_UPDATE_ITERS)))
 	{
-		if (collidersAddedRemoved || (treeUpdateCount >= MAX_TREE_UPDATE_ITERS))
-		{
-			// Either new colliders got added / removed or BVH tree has been rebuilt a lot of times. 
-			// 1. When a new collider gets added / removed, we can add / remove just it from the tree instead of
-			//    building the entire tree again. However, in 1 frame update, multiple colliders can be added / removed.
-			//    The BVH tree would be changed and its nodes would be recallibrated for each new collider.
-			//    It seems better to just build a new BVH tree.
-			// 2. In each rebuilt, its AABBs are adjusted. These adjustments could easily lead to inefficiencies
-			//    over time. Hence, its important to recreate a fully-efficient BVH tree every once a while.
-			bvhTree->Destroy();
-			BuildNewBVHTree();
-
-			treeUpdateCount = 0;
-			collidersAddedRemoved = false;
-		}
-		else
-		{
-			bvhTree->RebuildTree();
+		// Either new colliders got added / removed or BVH tree has been rebuilt a lot of times. 
+		// 1. When a new collider gets added / removed, we can add / remove just it from the tree instead of
+		//    building the entire tree again. However, in 1 frame update, multiple colliders can be added / removed.
+		//    The BVH tree would be changed and its nodes would be recallibrated for each new collider.
+		//    It seems better to just build a new BVH tree.
+		// 2. In each rebuilt, its AABBs are adjusted. These adjustments could easily lead to inefficiencies
+		//    over time. Hence, its important to recreate a fully-efficient BVH tree every once a while.
+		// Building takes a while, so it's done in the background. Colliders added / removed meanwhile
+		// get picked up by the next build.
+		StartBVHBuild();
+
+		treeUpdateCount = 0;
+		collidersAddedRemoved = false;
+	}
+
+	// Old tree keeps getting refit till the new one is ready
+	if (updateTree)
+	{
+		RefitBVHTree();
+		++treeUpdateCount;
+	}
+}
+
+void CollisionSystem::StartBVHBuild()
+{
+	buildItems.clear();
+	for (Collider* collider : colliders)
+	{
+		if (collider->GetColliderType() != BOX)
+			continue;
+
+		BVHBuildItem item;
+		item.boundingBox = static_cast<BoxCollider*>(collider)->boundingBox;
+		item.collider = static_cast<BoxCollider*>(collider);
+		item.handle = collider->collisionHandle;
+		buildItems.push_back(item);
+	}
+
+	isBuilding = true;
+	buildFinished.store(false);
+	BVH* tree = buildTree;
+	JobSystem::Get().Schedule([this, tree]() {
+		tree->Destroy();
+		tree->BuildTree(buildItems);
+		buildFinished.store(true, std::memory_order_release);
+	});
+}
+
+void CollisionSystem::RefitBVHTree()
+{
+	// Queries may be running on the active tree, so a copy gets refit
+	BVH* oldTree = activeTree.load();
+	spareTree->CopyTree(*oldTree);
+	spareTree->DropRemovedColliders(colliders);
+	spareTree->RebuildTree();
 
+	activeTree.store(spareTree, std::memory_order_release);
+	spareTree = oldTree;
+
+	// BVH covers the current position of all the colliders again
+	ClearMovedColliders();
+}
+
+void CollisionSystem::FinishBVHBuild()
+{
+	if (!isBuilding || !buildFinished.load(std::memory_order_acquire))
+	{
+		// Removed colliders may be back in their pool by the next frame, so they leave the active tree now
+		if (collidersRemoved)
+		{
+			collidersRemoved = false;
+			RefitBVHTree();
 			++treeUpdateCount;
 		}
+		return;
 	}
+	isBuilding = false;
+	collidersRemoved = false;
+
+	// Colliders removed during the build may be gone already, so they must not be read (or published).
+	// Then catch up with the colliders which moved during the build.
+	buildTree->DropRemovedColliders(colliders);
+	buildTree->RebuildTree();
+
+	BVH* oldTree = activeTree.load();
+	activeTree.store(buildTree, std::memory_order_release);
+	buildTree = oldTree;
+
+	ClearMovedColliders();
 }
 
 void CollisionSystem::Destroy()
 {
-	if (bvhTree != nullptr)
+	StopRecording();
+
+	// Build job uses the trees
+	while (isBuilding && !buildFinished.load())
+	{
+		std::this_thread::yield();
+	}
+	isBuilding = false;
+
+	activeTree.store(nullptr);
+	spareTree = nullptr;
+	buildTree = nullptr;
+	for (BVH*& tree : bvhTrees)
+	{
+		if (tree != nullptr)
+		{
+			tree->Destroy();
+			delete tree;
+			tree = nullptr;
+		}
+	}
+}
+
+bool CollisionSystem::StartRecording(const std::string& filename)
+{
+	StopRecording();
+	recordingFile.open(filename, std::ios::binary);
+	if (!recordingFile.is_open())
+	{
+		Logger::Get().Log("Could not open " + filename + " to record the broadphase", ERROR_LOG);
+		return false;
+	}
+
+	BroadphaseRecording::WriteHeader(recordingFile);
+	Logger::Get().Log("Recording the broadphase to " + filename);
+	return true;
+}
+
+void CollisionSystem::StopRecording()
+{
+	if (recordingFile.is_open())
+		recordingFile.close();
+}
+
+void CollisionSystem::RecordFrame()
+{
+	if (!recordingFile.is_open())
+		return;
+
+	recordedFrame.clear();
+	for (Collider* collider : colliders)
 	{
-		bvhTree->Destroy();
-		delete bvhTree;
+		if (collider->GetColliderType() != BOX)
+			continue;
+
+		// A new collider doesn't get the handle of a removed one, so handles identify colliders across frames
+		RecordedBox box;
+		box.id = collider->collisionHandle;
+		box.boundingBox = static_cast<BoxCollider*>(collider)->boundingBox;
+		recordedFrame.push_back(box);
 	}
+	BroadphaseRecording::WriteFrame(recordingFile, recordedFrame);
 }
 
 void CollisionSystem::AddCollider(Collider* collider)
 {
-	colliders.push_back(collider);
+	collider->collisionHandle = colliders.Add(collider);
 	collidersAddedRemoved = true;
+
+	if (collider->activatesTriggers)
+		collider->activatorHandle = triggerActivators.Add(collider);
 }
 
 void CollisionSystem::RemoveCollider(Collider* collider)
 {
-	colliders.remove(collider);
+	colliders.Remove(collider->collisionHandle);
+	collider->collisionHandle = INVALID_REGISTRY_HANDLE;
 	collidersAddedRemoved = true;
+	collidersRemoved = true;
+
+	// Forget its trigger overlaps. Removed colliders don't get exit events.
+	triggerActivators.Remove(collider->activatorHandle);
+	collider->activatorHandle = INVALID_REGISTRY_HANDLE;
+	triggerOverlaps.erase(std::remove_if(triggerOverlaps.begin(), triggerOverlaps.end(), [collider](const TriggerOverlap& overlap) {
+		return overlap.first == collider || overlap.second == collider;
+	}), triggerOverlaps.end());
+	if (collider->GetColliderType() == BOX)
+	{
+		BoxCollider* boxC = static_cast<BoxCollider*>(collider);
+		if (boxC->movedSinceBVHUpdate)
+		{
+			boxC->movedSinceBVHUpdate = false;
+			movedColliders.erase(std::find(movedColliders.begin(), movedColliders.end(), boxC));
+		}
+	}
+
+	// Bodies sleeping on this collider must fall now
+	if (collider->GetColliderType() == BOX && !collider->isTrigger)
+		PhysicsSystem::Get().WakeBodiesTouching(static_cast<BoxCollider*>(collider)->boundingBox);
 }
 
-void CollisionSystem::BuildNewBVHTree()
+void CollisionSystem::BuildNewBVHTree(BVH* tree)
 {
 	std::vector<BoxCollider*> boxColliders;
 	for (Collider* collider : colliders)
@@ -92,27 +247,223 @@ void CollisionSystem::BuildNewBVHTree()
 		if (collider->GetColliderType() == BOX)
 			boxColliders.push_back(static_cast<BoxCollider*>(collider));
 	}
-	bvhTree->BuildTree(boxColliders);
+	tree->BuildTree(boxColliders);
 }
 
 Collider* CollisionSystem::CheckCollision(Collider* collider, ColliderTag colliderTag)
 {
-	if (collider->GetColliderType() == BOX)
+	Vector3 _;  // Normal isn't required here
+	return CheckCollision(collider, colliderTag, _);
+}
+
+Vector3 CollisionSystem::GetCollisionNormal(Collider* collider, ColliderTag colliderTag)
+{
+	Vector3 normal(0.0f, 0.0f, 0.0f);
+	CheckCollision(collider, colliderTag, normal);
+	return normal;
+}
+
+Collider* CollisionSystem::CheckCollision(Collider* collider, ColliderTag colliderTag, Vector3& normal) const
+{
+	// Reads the moved colliders, which only the main thread keeps (see CollisionSystem)
+	assert(JobSystem::GetThreadIndex() == 0);
+	// Not supporting any other collisions yet
+	if (collider->GetColliderType() != BOX)
+		return nullptr;
+
+	BoxCollider* boxC = static_cast<BoxCollider*>(collider);
+	BVH* tree = activeTree.load(std::memory_order_acquire);
+	// Colliders removed since the last refit are still in the tree
+	BoxCollider* collidedWith = tree->CheckCollisions(boxC, normal, colliderTag, &colliders);
+	if (collidedWith != nullptr)
+		return collidedWith;
+
+	for (BoxCollider* moved : movedColliders)
 	{
-		return bvhTree->CheckCollisions(static_cast<BoxCollider*>(collider), colliderTag);
+		if (!moved->isTrigger && moved != boxC && (colliderTag == GENERIC || moved->colliderTag == colliderTag) &&
+			moved->boundingBox.Intersects(boxC->boundingBox))
+		{
+			normal = boxC->boundingBox.GetIntersectionNormal(moved->boundingBox);
+			return moved;
+		}
 	}
-	
-	// Not supporting any other collisions yet
 	return nullptr;
 }
 
-Vector3 CollisionSystem::GetCollisionNormal(Collider* collider, ColliderTag colliderTag)
+void CollisionSystem::DropStaleResults(std::vector<BoxCollider*>& result, size_t firstResult) const
 {
-	if (collider->GetColliderType() == BOX)
+	result.erase(std::remove_if(result.begin() + firstResult, result.end(), [this](BoxCollider* boxC) {
+		return boxC->movedSinceBVHUpdate || !colliders.IsValid(boxC->collisionHandle);
+	}), result.end());
+}
+
+bool CollisionSystem::MatchesQuery(BoxCollider* boxC, ColliderTagMask tagMask, bool triggers)
+{
+	return boxC->IsTrigger() == triggers && (tagMask & ColliderTagBit(boxC->GetColliderTag())) != 0;
+}
+
+size_t CollisionSystem::QueryOverlaps(const AABB& aabb, std::vector<BoxCollider*>& result, ColliderTagMask tagMask, bool triggers) const
+{
+	assert(JobSystem::GetThreadIndex() == 0);
+	size_t firstResult = result.size();
+	activeTree.load(std::memory_order_acquire)->QueryOverlaps(aabb, result, triggers, tagMask);
+
+	DropStaleResults(result, firstResult);
+	for (BoxCollider* moved : movedColliders)
 	{
-		return bvhTree->GetCollisionNormal(static_cast<BoxCollider*>(collider), colliderTag);
+		if (MatchesQuery(moved, tagMask, triggers) && moved->boundingBox.Intersects(aabb))
+			result.push_back(moved);
 	}
+	return result.size() - firstResult;
+}
 
-	// Not supporting any other collisions yet
-	return Vector3(0.0f, 0.0f, 0.0f);
+size_t CollisionSystem::QuerySphereOverlaps(const Vector3& center, float radius, std::vector<BoxCollider*>& result, ColliderTagMask tagMask, bool triggers) const
+{
+	assert(JobSystem::GetThreadIndex() == 0);
+	size_t firstResult = result.size();
+	activeTree.load(std::memory_order_acquire)->QuerySphereOverlaps(center, radius, result, triggers, tagMask);
+
+	DropStaleResults(result, firstResult);
+	for (BoxCollider* moved : movedColliders)
+	{
+		if (MatchesQuery(moved, tagMask, triggers) && moved->boundingBox.IntersectsSphere(center, radius))
+			result.push_back(moved);
+	}
+	return result.size() - firstResult;
+}
+
+size_t CollisionSystem::QueryZRangeOverlaps(float minZ, float maxZ, std::vector<BoxCollider*>& result, ColliderTagMask tagMask, bool triggers) const
+{
+	const float infinity = std::numeric_limits<float>::max();
+	AABB range(Vector3(-infinity, -infinity, minZ), Vector3(infinity, infinity, maxZ));
+	return QueryOverlaps(range, result, tagMask, triggers);
+}
+
+void CollisionSystem::UpdateTriggerActivator(Collider* collider)
+{
+	// Colliders not in the collision system get added as per their flag later
+	if (!colliders.IsValid(collider->collisionHandle))
+		return;
+
+	if (collider->activatesTriggers && !triggerActivators.IsValid(collider->activatorHandle))
+	{
+		collider->activatorHandle = triggerActivators.Add(collider);
+	}
+	else if (!collider->activatesTriggers)
+	{
+		triggerActivators.Remove(collider->activatorHandle);
+		collider->activatorHandle = INVALID_REGISTRY_HANDLE;
+	}
+}
+
+void CollisionSystem::MarkColliderMoved(BoxCollider* boxCollider)
+{
+	assert(JobSystem::GetThreadIndex() == 0);
+	if (boxCollider->movedSinceBVHUpdate || !colliders.IsValid(boxCollider->collisionHandle))
+		return;
+
+	boxCollider->movedSinceBVHUpdate = true;
+	movedColliders.push_back(boxCollider);
+}
+
+void CollisionSystem::ClearMovedColliders()
+{
+	for (BoxCollider* boxC : movedColliders)
+		boxC->movedSinceBVHUpdate = false;
+	movedColliders.clear();
+}
+
+void CollisionSystem::AddTriggerOverlap(TriggerCollider* trigger, Collider* activator)
+{
+	if (trigger == activator)
+		return;
+	if (trigger->triggerTag != GENERIC && trigger->triggerTag != activator->colliderTag)
+		return;
+
+	newTriggerOverlaps.push_back({ trigger, activator });
+}
+
+bool CollisionSystem::TriggerOverlapLess(const TriggerOverlap& a, const TriggerOverlap& b)
+{
+	if (a.first->collisionHandle != b.first->collisionHandle)
+		return a.first->collisionHandle < b.first->collisionHandle;
+	return a.second->collisionHandle < b.second->collisionHandle;
+}
+
+void CollisionSystem::UpdateTriggers()
+{
+	assert(JobSystem::GetThreadIndex() == 0);
+	newTriggerOverlaps.clear();
+	for (Collider* activator : triggerActivators)
+	{
+		if (activator->GetColliderType() != BOX)
+			continue;
+
+		// Activator might have moved after its own update (by the physics system for example)
+		activator->Callibrate();
+		const AABB& box = static_cast<BoxCollider*>(activator)->boundingBox;
+
+		triggerQuery.clear();
+		activeTree.load(std::memory_order_acquire)->QueryOverlaps(box, triggerQuery, true);
+		// Removed triggers are still in the tree & moved ones are checked below
+		DropStaleResults(triggerQuery, 0);
+		for (BoxCollider* boxC : triggerQuery)
+		{
+			AddTriggerOverlap(static_cast<TriggerCollider*>(boxC), activator);
+		}
+
+		for (BoxCollider* moved : movedColliders)
+		{
+			if (moved->isTrigger && moved->boundingBox.Intersects(box))
+				AddTriggerOverlap(static_cast<TriggerCollider*>(moved), activator);
+		}
+	}
+	std::sort(newTriggerOverlaps.begin(), newTriggerOverlaps.end(), TriggerOverlapLess);
+
+	// Overlaps only in the new list began this frame & the ones only in the old list ended
+	triggerEvents.clear();
+	size_t oldIdx = 0, newIdx = 0;
+	while (oldIdx < triggerOverlaps.size() || newIdx < newTriggerOverlaps.size())
+	{
+		bool isEnter;
+		TriggerOverlap overlap;
+		if (oldIdx == triggerOverlaps.size() || (newIdx < newTriggerOverlaps.size() && TriggerOverlapLess(newTriggerOverlaps[newIdx], triggerOverlaps[oldIdx])))
+		{
+			overlap = newTriggerOverlaps[newIdx++];
+			isEnter = true;
+		}
+		else if (newIdx == newTriggerOverlaps.size() || TriggerOverlapLess(triggerOverlaps[oldIdx], newTriggerOverlaps[newIdx]))
+		{
+			overlap = triggerOverlaps[oldIdx++];
+			isEnter = false;
+		}
+		else
+		{
+			// Still overlapping
+			++oldIdx;
+			++newIdx;
+			continue;
+		}
+
+		TriggerEvent triggerEvent;
+		triggerEvent.trigger = overlap.first;
+		triggerEvent.other = overlap.second;
+		triggerEvent.triggerHandle = overlap.first->collisionHandle;
+		triggerEvent.otherHandle = overlap.second->collisionHandle;
+		triggerEvent.isEnter = isEnter;
+		triggerEvents.push_back(triggerEvent);
+	}
+	triggerOverlaps.swap(newTriggerOverlaps);
+
+	// Callbacks may add or remove colliders, so events are fired only after the overlaps are updated
+	for (TriggerEvent& triggerEvent : triggerEvents)
+	{
+		if (!colliders.IsValid(triggerEvent.triggerHandle) || !colliders.IsValid(triggerEvent.otherHandle))
+			continue;
+
+		if (triggerEvent.isEnter)
+			triggerEvent.trigger->OnTriggerEnter(triggerEvent.other);
+		else
+			triggerEvent.trigger->OnTriggerExit(triggerEvent.other);
+	}
 }
@@ -7,11 +7,28 @@
 #define _COLLISION_SYSTEM_H_
 
 #include "Engine/Components/Collider.h"
+#include "Engine/Algorithms/BVH.h"
+#include "Engine/Algorithms/BroadphaseRecording.h"
 
 class Vector3;
 class Entity;
 class BVH;
+class AABB;
+class BoxCollider;
+class TriggerCollider;
 
+/**
+ * @class CollisionSystem
+ *
+ * The BVH is never changed in place. Queries run on the active tree, which never changes while it is active.
+ * Refits are done on a copy & full rebuilds on a worker thread, so a rebuild never blocks the frame.
+ * New trees are published with a single atomic store at the end of a frame.
+ *
+ * Colliders moved after the active tree was built (triggers & kinematic bodies) are kept in a short list
+ * & checked directly. That list is a plain vector, changed by MarkColliderMoved & the refits.
+ * So all the queries (CheckCollision, Query*Overlaps, UpdateTriggers) must run on the main thread, like
+ * everything that moves or removes colliders. Worker threads only ever touch the tree being built.
+ */
 class CollisionSystem
 {
 	DECLARE_SINGLETON(CollisionSystem)
@@ -22,12 +39,70 @@ class CollisionSystem
 	short int MAX_TREE_UPDATE_ITERS = 100;
 	short int treeUpdateCount = 0;
 
-	std::list<Collider*> colliders;
-	// BVH for box colliders
-	BVH* bvhTree = nullptr;
+	DenseRegistry<Collider*> colliders;
+	// BVH trees for box colliders. Queries use the active one, refits go to the spare one
+	// & rebuilds to the build one. They swap roles as new trees get published.
+	BVH* bvhTrees[3] = { nullptr, nullptr, nullptr };
+	std::atomic<BVH*> activeTree{ nullptr };
+	BVH* spareTree = nullptr;
+	BVH* buildTree = nullptr;
 	bool collidersAddedRemoved = false;
+	// Colliders removed since the last refit. The active tree still has them till the end of the frame,
+	// so every query skips them.
+	bool collidersRemoved = false;
 
-	void BuildNewBVHTree();
+	// ---------------- Background rebuild ----------------
+	// Boxes copied when the rebuild started. Only the build job reads them.
+	std::vector<BVHBuildItem> buildItems;
+	bool isBuilding = false;
+	// Set by the build job once the new tree is ready
+	std::atomic<bool> buildFinished{ false };
+
+	// Colliders moved since the active tree was built. Its nodes may not cover them, so they are checked directly.
+	std::vector<BoxCollider*> movedColliders;
+	// Drop the tree's query results for moved colliders (queries check all of them directly instead)
+	// & for colliders removed since the last refit.
+	void DropStaleResults(std::vector<BoxCollider*>& result, size_t firstResult) const;
+	static bool MatchesQuery(BoxCollider* boxC, ColliderTagMask tagMask, bool triggers);
+
+	// ---------------- Triggers ----------------
+	// Colliders which set off triggers. Each one queries the BVH for triggers once per frame.
+	DenseRegistry<Collider*> triggerActivators;
+
+	using TriggerOverlap = std::pair<TriggerCollider*, Collider*>;
+	// Overlaps of the last frame, sorted
+	std::vector<TriggerOverlap> triggerOverlaps;
+	std::vector<TriggerOverlap> newTriggerOverlaps;
+	// Orders overlaps by collision handles instead of pointers, so that events fire in the same order on every run
+	static bool TriggerOverlapLess(const TriggerOverlap& a, const TriggerOverlap& b);
+	std::vector<BoxCollider*> triggerQuery;
+
+	struct TriggerEvent
+	{
+		TriggerCollider* trigger = nullptr;
+		Collider* other = nullptr;
+		// A callback can remove colliders. Events of removed colliders must not fire.
+		RegistryHandle triggerHandle = INVALID_REGISTRY_HANDLE;
+		RegistryHandle otherHandle = INVALID_REGISTRY_HANDLE;
+		bool isEnter = true;
+	};
+	std::vector<TriggerEvent> triggerEvents;
+
+	// ---------------- Broadphase recording ----------------
+	std::ofstream recordingFile;
+	std::vector<RecordedBox> recordedFrame;
+
+	void BuildNewBVHTree(BVH* tree);
+	/**
+	 * @brief Build a new tree on a worker thread from a copy of the current boxes.
+	 */
+	void StartBVHBuild();
+	/**
+	 * @brief Refit a copy of the active tree & publish it.
+	 */
+	void RefitBVHTree();
+	void ClearMovedColliders();
+	void AddTriggerOverlap(TriggerCollider* trigger, Collider* activator);
 
 public:
 	/**
@@ -51,16 +126,80 @@ public:
 	 */
 	Vector3 GetCollisionNormal(Collider* collider, ColliderTag colliderTag = GENERIC);
 
+	/**
+	 * @brief Check for collision & get the normal to the collision plane in a single query.
+	 *
+	 * @param normal Set to the collision normal if there was a collision
+	 * @return Collider pointer if there was a collision. Else, nullptr.
+	 */
+	Collider* CheckCollision(Collider* collider, ColliderTag colliderTag, Vector3& normal) const;
+
+	/**
+	 * @brief Find the box colliders overlapping an AABB.
+	 * Results are appended to the caller's buffer, so a reused buffer doesn't allocate.
+	 *
+	 * @param aabb Region to check
+	 * @param result Overlapping colliders get appended to it
+	 * @param tagMask Only colliders with these tags are found (see ColliderTagBit)
+	 * @param triggers Find the triggers instead of the solid colliders
+	 * @return Number of colliders appended
+	 */
+	size_t QueryOverlaps(const AABB& aabb, std::vector<BoxCollider*>& result, ColliderTagMask tagMask = ALL_COLLIDER_TAGS, bool triggers = false) const;
+
+	/**
+	 * @brief Find the box colliders overlapping a sphere. Works like QueryOverlaps.
+	 */
+	size_t QuerySphereOverlaps(const Vector3& center, float radius, std::vector<BoxCollider*>& result, ColliderTagMask tagMask = ALL_COLLIDER_TAGS, bool triggers = false) const;
+
+	/**
+	 * @brief Find the box colliders overlapping a range along Z (the direction of the game). Works like QueryOverlaps.
+	 * Useful for things like "everything behind the player".
+	 */
+	size_t QueryZRangeOverlaps(float minZ, float maxZ, std::vector<BoxCollider*>& result, ColliderTagMask tagMask = ALL_COLLIDER_TAGS, bool triggers = false) const;
+
+	/**
+	 * @brief Save the boxes of all box colliders every frame, till StopRecording.
+	 * Recordings get replayed by BroadphaseBenchmark to compare broadphases on real gameplay.
+	 *
+	 * @return False if the file couldn't be opened.
+	 */
+	bool StartRecording(const std::string& filename);
+	void StopRecording();
+	bool IsRecording() const { return recordingFile.is_open(); }
+
 protected:
 	void AddCollider(Collider*);
 	void RemoveCollider(Collider*);
 
+	// Called by the colliders when their trigger settings change
+	void UpdateTriggerActivator(Collider*);
+	// Called when a box moves outside the regular update (triggers & kinematic bodies)
+	void MarkColliderMoved(BoxCollider*);
+
 	void Initialize();
 	void Update();
+	/**
+	 * @brief Find the triggers overlapping the activators & report the overlaps which began or ended.
+	 * Runs every frame.
+	 */
+	void UpdateTriggers();
+	/**
+	 * @brief Publish the tree built in the background, if it is ready. Runs at the end of every frame.
+	 * Colliders removed during the build get dropped from it & the moved ones get covered by a refit first.
+	 * Otherwise, if colliders were removed in the frame, the active tree gets refit without them.
+	 */
+	void FinishBVHBuild();
+	/**
+	 * @brief Write the boxes of the frame to the recording, if recording. Runs at the end of every frame.
+	 */
+	void RecordFrame();
 	void Destroy();
 
 	friend class Engine;
 	friend class EntityPool;
+	friend class Collider;
+	friend class TriggerCollider;
+	friend class PhysicsSystem;
 };
 
 #endif // !_COLLISION_SYSTEM_H_
@@ -0,0 +1,153 @@
+// @file: DebrisSystem.cpp
+//
+// @brief: Cpp file for DebrisSystem, a singleton simulating & rendering short-lived mesh fragments.
+
+#include "stdafx.h"
+#include "Engine/Systems/DebrisSystem.h"
+#include "Engine/Systems/PhysicsSystem.h"
+#include "Engine/Components/MeshRenderer.h"
+#include "Engine/Math/Random.h"
+#include "Engine/Core/Logger.h"
+
+void DebrisSystem::Initialize()
+{
+	positionX.assign(MAX_FRAGMENTS, 0.0f);
+	positionY.assign(MAX_FRAGMENTS, 0.0f);
+	positionZ.assign(MAX_FRAGMENTS, 0.0f);
+	velocityX.assign(MAX_FRAGMENTS, 0.0f);
+	velocityY.assign(MAX_FRAGMENTS, 0.0f);
+	velocityZ.assign(MAX_FRAGMENTS, 0.0f);
+	lifeLeft.assign(MAX_FRAGMENTS, 0.0f);
+	fragmentMeshes.assign(MAX_FRAGMENTS, -1);
+	localMatrices.assign(MAX_FRAGMENTS, Matrix4x4());
+	colors.assign(MAX_FRAGMENTS, Vector3());
+
+	nextFragment = 0;
+	aliveFragments = 0;
+}
+
+int DebrisSystem::LoadMesh(const std::string& objFile)
+{
+	auto itr = meshIds.find(objFile);
+	if (itr != meshIds.end())
+		return itr->second;
+
+	Mesh mesh;
+	mesh.LoadFromObjectFile(objFile);
+	int meshId = -1;
+	if (mesh.faces.size() > 0)
+	{
+		meshId = static_cast<int>(meshes.size());
+		meshes.push_back(mesh);
+	}
+	else
+	{
+		Logger::Get().Log("Debris mesh " + objFile + " has no faces", WARNING_LOG);
+	}
+
+	// Empty meshes are cached too, so that the file isn't read again
+	meshIds[objFile] = meshId;
+	return meshId;
+}
+
+void DebrisSystem::SpawnBurst(const std::vector<int>& burstMeshes, const DebrisBurst& burst)
+{
+	Vector3 rotation = burst.rotation;
+	Vector3 scale = burst.scale;
+	Matrix4x4 localMatrix = Matrix4x4::CreateScale(scale) * Matrix4x4::CreateRotation(rotation);
+
+	for (int meshId : burstMeshes)
+	{
+		if (meshId < 0)
+			continue;
+
+		size_t idx = nextFragment;
+		nextFragment = (nextFragment + 1) % MAX_FRAGMENTS;
+		// Oldest fragment gets replaced if the ring is full
+		if (lifeLeft[idx] <= 0.0f)
+			++aliveFragments;
+
+		positionX[idx] = burst.position.x;
+		positionY[idx] = burst.position.y + (Random::Get().Float() * 2.0f - 1.0f) * burst.verticalJitter;
+		positionZ[idx] = burst.position.z;
+
+		Vector3 velocity{ (Random::Get().Float() * 2.0f - 1.0f) * burst.velocitySpread.x,
+						  Random::Get().Float() * burst.velocitySpread.y,
+						  Random::Get().Float() * burst.velocitySpread.z };
+		velocity.Normalize();
+		velocity *= burst.speed;
+		velocityX[idx] = velocity.x;
+		velocityY[idx] = velocity.y;
+		velocityZ[idx] = velocity.z;
+
+		lifeLeft[idx] = burst.lifeTime;
+		fragmentMeshes[idx] = meshId;
+		localMatrices[idx] = localMatrix;
+		colors[idx] = burst.color;
+	}
+}
+
+void DebrisSystem::KillFragment(size_t idx)
+{
+	lifeLeft[idx] = 0.0f;
+	--aliveFragments;
+}
+
+void DebrisSystem::Clear()
+{
+	for (size_t idx = 0; idx < lifeLeft.size(); idx++)
+		lifeLeft[idx] = 0.0f;
+	aliveFragments = 0;
+}
+
+void DebrisSystem::Update(float deltaTime)
+{
+	if (aliveFragments == 0)
+		return;
+
+	float dt = deltaTime / 1000.0f;
+	float gravityDelta = PhysicsSystem::Get().GetGravity() * dt;
+
+	for (size_t idx = 0; idx < MAX_FRAGMENTS; idx++)
+	{
+		if (lifeLeft[idx] <= 0.0f)
+			continue;
+
+		velocityY[idx] += gravityDelta;
+		positionX[idx] += velocityX[idx] * dt;
+		positionY[idx] += velocityY[idx] * dt;
+		positionZ[idx] += velocityZ[idx] * dt;
+
+		lifeLeft[idx] -= dt;
+		if (lifeLeft[idx] <= 0.0f || positionY[idx] < killHeight)
+		{
+			KillFragment(idx);
+			continue;
+		}
+
+		// Simplified floor: bounce back with lower speed & slow down horizontally
+		if (floorEnabled && positionY[idx] < floorHeight)
+		{
+			positionY[idx] = floorHeight;
+			if (velocityY[idx] < 0.0f)
+				velocityY[idx] = -velocityY[idx] * floorRestitution;
+			velocityX[idx] *= floorFriction;
+			velocityZ[idx] *= floorFriction;
+		}
+	}
+}
+
+void DebrisSystem::Render()
+{
+	if (aliveFragments == 0)
+		return;
+
+	for (size_t idx = 0; idx < MAX_FRAGMENTS; idx++)
+	{
+		if (lifeLeft[idx] <= 0.0f)
+			continue;
+
+		Matrix4x4 mWorld = localMatrices[idx] * Matrix4x4::CreateTranslation(positionX[idx], positionY[idx], positionZ[idx]);
+		MeshRenderer::RenderMesh(meshes[fragmentMeshes[idx]], mWorld, colors[idx], false);
+	}
+}
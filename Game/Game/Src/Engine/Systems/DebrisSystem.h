@@ -0,0 +1,111 @@
+// @file: DebrisSystem.h
+//
+// @brief: Header file for DebrisSystem, a singleton simulating & rendering short-lived mesh fragments.
+
+#pragma once
+#ifndef _DEBRIS_SYSTEM_H_
+#define _DEBRIS_SYSTEM_H_
+
+#include "Engine/Math/Mesh.h"
+#include "Engine/Math/Vector3.h"
+#include "Engine/Math/Matrix4x4.h"
+
+// Settings of a group of fragments spawned together
+struct DebrisBurst
+{
+	// Transform of the broken object
+	Vector3 position{ 0.0f, 0.0f, 0.0f };
+	Vector3 rotation{ 0.0f, 0.0f, 0.0f };
+	Vector3 scale{ 1.0f, 1.0f, 1.0f };
+	Vector3 color{ 1.0f, 1.0f, 1.0f };
+
+	// Direction of a fragment is (rand[-1, 1] * x, rand[0, 1] * y, rand[0, 1] * z), normalized
+	Vector3 velocitySpread{ 1.0f, 1.0f, 1.0f };
+	float speed = 20.0f;
+	// Fragments start up to this far above / below the position
+	float verticalJitter = 1.0f;
+	// In seconds
+	float lifeTime = 3.0f;
+};
+
+/**
+ * @class DebrisSystem
+ *
+ * Fragments of broken objects only fly away & vanish, so they don't need to be entities.
+ * DebrisSystem keeps them in a fixed-size ring (the oldest fragment gets replaced when it is full),
+ * stores their data as separate arrays & moves all of them in one tight loop.
+ * Fragments don't collide with anything except an optional floor.
+ *
+ * Meshes are loaded once & shared by all the fragments using them.
+ */
+class DebrisSystem
+{
+	DECLARE_SINGLETON(DebrisSystem)
+
+	static const size_t MAX_FRAGMENTS = 256;
+
+	std::vector<Mesh> meshes;
+	std::unordered_map<std::string, int> meshIds;
+
+	// ---------------- Fragment data ----------------
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> positionZ;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> velocityZ;
+	// Seconds left before the fragment vanishes. Fragment is dead if <= 0.
+	std::vector<float> lifeLeft;
+	std::vector<int> fragmentMeshes;
+	// Scale & rotation of a fragment never change, so they are combined once on spawn
+	std::vector<Matrix4x4> localMatrices;
+	std::vector<Vector3> colors;
+
+	// Ring index of the next fragment to spawn
+	size_t nextFragment = 0;
+	size_t aliveFragments = 0;
+
+	// ---------------- Settings ----------------
+	bool floorEnabled = false;
+	float floorHeight = 0.0f;
+	// Fraction of the vertical speed kept on bouncing off the floor
+	float floorRestitution = 0.3f;
+	// Fraction of the horizontal speed kept on hitting the floor
+	float floorFriction = 0.8f;
+	// Fragments falling below this vanish
+	float killHeight = -20.0f;
+
+	void KillFragment(size_t idx);
+
+public:
+	/**
+	 * @brief Load a mesh to be used for fragments. Loading the same file again returns the cached mesh.
+	 * @return Mesh ID, or -1 if the mesh has no faces.
+	 */
+	int LoadMesh(const std::string& objFile);
+
+	/**
+	 * @brief Spawn a fragment for each mesh.
+	 */
+	void SpawnBurst(const std::vector<int>& meshes, const DebrisBurst& burst);
+
+	/**
+	 * @brief Remove all fragments. Loaded meshes are kept.
+	 */
+	void Clear();
+
+	void SetFloor(bool enable, float height = 0.0f) { floorEnabled = enable; floorHeight = height; }
+	void SetKillHeight(float height) { killHeight = height; }
+	size_t GetFragmentCount() const { return aliveFragments; }
+
+protected:
+	void Initialize();
+	void Update(float);
+	void Render();
+
+	friend class Engine;
+	friend class RenderSystem;
+	friend class TestDebrisSystem;
+};
+
+#endif // !_DEBRIS_SYSTEM_H_
@@ -2,11 +2,15 @@
 #include "App/app.h"
 #include "Engine/Systems/Engine.h"
 #include "Engine/Core/Logger.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Systems/SceneManager.h"
+#include "Engine/Systems/Scene.h"
 #include "Engine/Systems/RenderSystem.h"
 #include "Engine/Systems/CollisionSystem.h"
 #include "Engine/Systems/PhysicsSystem.h"
+#include "Engine/Systems/DebrisSystem.h"
 #include "Engine/Pools/EntityPool.h"
+#include "Engine/Math/Random.h"
 
 void Engine::Wakeup()
 {
@@ -17,6 +21,11 @@ void Engine::Wakeup()
 void Engine::Initialize()
 {
 	timeElapsed = 0.0f;
+	frameIndex = 0;
+
+	// Worker threads are used by the systems, so they must be up first
+	JobSystem::Get().Initialize();
+	DebrisSystem::Get().Initialize();
 
 	// Scene entities must be loaded before they can be initialized
 	SceneManager::Get().Load();
@@ -25,36 +34,121 @@ void Engine::Initialize()
 	SceneManager::Get().Initialize();
 	RenderSystem::Get().Initialize();
 	CollisionSystem::Get().Initialize();
-}
 
-void Engine::Destroy()
-{
-	SceneManager::Get().Destroy();
-	CollisionSystem::Get().Destroy();
+	ScheduleSystems();
 }
 
-void Engine::Update(float deltaTime)
+void Engine::ScheduleSystems()
 {
-	timeElapsed += deltaTime;
+	const SystemResourceMask transforms = SystemResourceBit(TRANSFORM_DATA);
+	const SystemResourceMask bvh = SystemResourceBit(BVH_DATA);
+	const SystemResourceMask colliders = SystemResourceBit(COLLIDER_DATA);
+	const SystemResourceMask movedColliders = SystemResourceBit(MOVED_COLLIDER_DATA);
+
+	scheduler.Clear();
 
 	// --------------------- Pre-update Phase ---------------------
-	SceneManager::Get().PreUpdate();
+	scheduler.AddSystem("Scene PreUpdate", [](float) { SceneManager::Get().PreUpdate(); },
+		ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
 
 	// --------------------- Update Phase ---------------------
-	SceneManager::Get().Update(deltaTime);
-	RenderSystem::Get().Update(deltaTime);
-	PhysicsSystem::Get().Update(deltaTime);
+	// Game code can touch anything
+	scheduler.AddSystem("Scene Update", [](float deltaTime) { SceneManager::Get().Update(deltaTime); },
+		ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+	for (const GameSystem& system : gameSystems)
+	{
+		scheduler.AddSystem(system.name, system.func, system.reads, system.writes, system.mainThreadOnly);
+	}
+	// Camera follows its entity
+	scheduler.AddSystem("Camera", [](float deltaTime) { RenderSystem::Get().Update(deltaTime); },
+		transforms, SystemResourceBit(CAMERA_DATA), false);
+	scheduler.AddSystem("Particles", [](float deltaTime) { SceneManager::Get().UpdateParticles(deltaTime); },
+		SystemResourceBit(ENTITY_DATA), SystemResourceBit(PARTICLE_DATA), false);
+	// Kinematic bodies get marked as moved in the collision system
+	scheduler.AddSystem("Physics", [](float deltaTime) { PhysicsSystem::Get().Update(deltaTime); },
+		bvh, transforms | SystemResourceBit(RIGIDBODY_DATA) | colliders | movedColliders, true);
+	scheduler.AddSystem("Debris", [](float deltaTime) { DebrisSystem::Get().Update(deltaTime); },
+		0, SystemResourceBit(DEBRIS_DATA), false);
+	// Collision & trigger callbacks run game code
+	scheduler.AddSystem("Collision Callbacks", [](float) { PhysicsSystem::Get().ReportCollisions(); },
+		ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+	scheduler.AddSystem("Triggers", [](float) { CollisionSystem::Get().UpdateTriggers(); },
+		ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
 
 	// --------------------- Post-update Phase ---------------------
-	SceneManager::Get().PostUpdate();
+	scheduler.AddSystem("Scene PostUpdate", [](float) { SceneManager::Get().PostUpdate(); },
+		ALL_SYSTEM_RESOURCES, ALL_SYSTEM_RESOURCES, true);
+
+	// Frame boundary: swap in the BVH built in the background (if it's ready),
+	// or drop the colliders removed in this frame from the active one
+	scheduler.AddSystem("BVH Swap", [](float) { CollisionSystem::Get().FinishBVHBuild(); },
+		colliders, bvh | movedColliders, true);
 
 	// Don't need to update collision system every frame
 	// Update it only once every x seconds
-	if (timeElapsed >= COLLISION_SYSTEM_UPDATE_TIME)
+	scheduler.AddSystem("Collision", [this](float) {
+		if (timeElapsed >= COLLISION_SYSTEM_UPDATE_TIME)
+		{
+			CollisionSystem::Get().Update();
+			timeElapsed = 0.0f;
+		}
+	}, colliders, bvh | movedColliders, true);
+	scheduler.AddSystem("Broadphase Recording", [](float) { CollisionSystem::Get().RecordFrame(); },
+		colliders, 0, true);
+}
+
+void Engine::AddGameSystem(const std::string& name, std::function<void(float)> func, SystemResourceMask reads, SystemResourceMask writes, bool mainThreadOnly)
+{
+	GameSystem system;
+	system.name = name;
+	system.func = func;
+	system.reads = reads;
+	system.writes = writes;
+	system.mainThreadOnly = mainThreadOnly;
+	gameSystems.push_back(system);
+}
+
+void Engine::Destroy()
+{
+	SceneManager::Get().Destroy();
+	CollisionSystem::Get().Destroy();
+	JobSystem::Get().Destroy();
+}
+
+void Engine::Update(float deltaTime)
+{
+	if (deterministic)
+		deltaTime = fixedDeltaTime;
+	timeElapsed += deltaTime;
+
+	// Phases & their systems are set up in ScheduleSystems
+	scheduler.Run(deltaTime);
+	if (logSystemTimings && frameIndex % TIMINGS_LOG_FRAMES == TIMINGS_LOG_FRAMES - 1)
+		scheduler.LogTimings();
+
+	if (logStateHash)
 	{
-		CollisionSystem::Get().Update();
-		timeElapsed = 0.0f;
+		lastStateHash = ComputeStateHash();
+		Logger::Get().Log("Frame " + std::to_string(frameIndex) + " state hash: " + std::to_string(lastStateHash), DEBUG_LOG);
 	}
+	++frameIndex;
+}
+
+void Engine::SetDeterministic(bool enable, unsigned int seed, float fixedTick)
+{
+	deterministic = enable;
+	fixedDeltaTime = fixedTick;
+	if (deterministic)
+		Random::Get().Seed(seed);
+}
+
+STRCODE Engine::ComputeStateHash() const
+{
+	STRCODE hash = HashBytes(nullptr, 0);
+	Scene* scene = SceneManager::Get().GetActiveScene();
+	if (scene != nullptr)
+		hash = scene->HashState(hash);
+	return PhysicsSystem::Get().HashState(hash);
 }
 
 void Engine::Render()
@@ -3,6 +3,8 @@
 #ifndef _ENGINE_H_
 #define _ENGINE_H_
 
+#include "Engine/Core/SystemScheduler.h"
+
 class Engine
 {
 	DECLARE_SINGLETON(Engine)
@@ -12,6 +14,42 @@ class Engine
 
 	float timeElapsed = 0.0f;
 
+	// Runs the systems of a frame, in parallel where they don't touch the same data
+	SystemScheduler scheduler;
+	// System timings are logged once every TIMINGS_LOG_FRAMES frames
+	const unsigned int TIMINGS_LOG_FRAMES = 600;
+	bool logSystemTimings = false;
+
+	// Systems added by the game, run right after the scene update
+	struct GameSystem
+	{
+		std::string name;
+		std::function<void(float)> func;
+		SystemResourceMask reads = 0;
+		SystemResourceMask writes = 0;
+		bool mainThreadOnly = true;
+	};
+	std::vector<GameSystem> gameSystems;
+
+	/**
+	 * @brief Add the systems of a frame to the scheduler, in the order they would run one after another.
+	 */
+	void ScheduleSystems();
+
+	// ---------------- Deterministic mode ----------------
+	// Every frame advances by fixedDeltaTime instead of the real frame time,
+	// so two runs with the same seed simulate exactly the same frames.
+	bool deterministic = false;
+	float fixedDeltaTime = 1000.0f / 60.0f;
+	bool logStateHash = false;
+	unsigned int frameIndex = 0;
+	STRCODE lastStateHash = 0;
+
+	/**
+	 * @brief Hash the transforms of the active scene & the state of all rigid bodies.
+	 */
+	STRCODE ComputeStateHash() const;
+
 public:
 	/**
 	 * @brief Anything that must be done before the game loads up.
@@ -25,6 +63,12 @@ public:
 	 */
 	void Initialize();
 
+	/**
+	 * @brief Add a game system to the frame, right after the scene update. Must be called before Initialize.
+	 * Works like SystemScheduler::AddSystem: it runs alongside the engine systems it doesn't conflict with.
+	 */
+	void AddGameSystem(const std::string& name, std::function<void(float)> func, SystemResourceMask reads, SystemResourceMask writes, bool mainThreadOnly);
+
 	/**
 	 * @brief Performs clean-up on all game systems.
 	 */
@@ -39,6 +83,29 @@ public:
 	 * @brief Renders entities.
 	 */
 	void Render();
+
+	/**
+	 * @brief Run the simulation with a fixed tick & a seeded random generator.
+	 * Player input is not recorded, so runs only match as long as the input does.
+	 *
+	 * @param seed Seed of the random generator.
+	 * @param fixedTick Milliseconds simulated per frame.
+	 */
+	void SetDeterministic(bool enable, unsigned int seed = 0, float fixedTick = 1000.0f / 60.0f);
+	bool IsDeterministic() const { return deterministic; }
+
+	/**
+	 * @brief Hash the simulation state after every frame & log it.
+	 * Logs of two runs (or two builds) can be diffed to find the first frame where they diverge.
+	 */
+	void SetLogStateHash(bool enable) { logStateHash = enable; }
+	// Hash of the last frame. Only computed if state hash logging is on.
+	STRCODE GetLastStateHash() const { return lastStateHash; }
+
+	/**
+	 * @brief Log the average & worst time of every system once in a while.
+	 */
+	void SetLogSystemTimings(bool enable) { logSystemTimings = enable; }
 };
 
 #endif
@@ -10,21 +10,37 @@
 #include "Engine/Components/BoxCollider.h"
 #include "Engine/Systems/CollisionSystem.h"
 #include "Engine/Core/Logger.h"
+#include "Engine/Core/JobSystem.h"
 
 void PhysicsSystem::AddRigidBody(RigidBody* rb)
 {
-	rigidBodies.push_back(rb);
+	rb->physicsHandle = rigidBodies.Add(rb);
 }
 
 void PhysicsSystem::RemoveRigidBody(RigidBody* rb)
 {
-	rigidBodies.remove(rb);
+	rigidBodies.Remove(rb->physicsHandle);
+	rb->physicsHandle = INVALID_REGISTRY_HANDLE;
 }
 
 void PhysicsSystem::Update(float deltaTime)
 {
+	// Kinematic bodies move first, so that dynamic bodies collide with them at their new position
 	for (RigidBody* rb : rigidBodies)
 	{
+		if (rb->isKinematic)
+			MoveKinematicBody(rb, deltaTime);
+	}
+
+	// Velocities get integrated first, so that the broadphase knows where each body is heading
+	movingBodies.clear();
+	for (RigidBody* rb : rigidBodies)
+	{
+		// Sleeping bodies cost nothing till something wakes them up.
+		// Kinematic bodies are never simulated, other bodies treat them like static colliders.
+		if (rb->isSleeping || rb->isKinematic)
+			continue;
+
 		// Update velocity as per acceleration (v = u + at)
 		rb->velocity += rb->instAcceleration * (deltaTime / 1000.0f);
 		// Instantaneous acceleration must be set to zero after it has been applied to the velocity
@@ -36,45 +52,624 @@ void PhysicsSystem::Update(float deltaTime)
 
 		// If the object is not moving, there's nothing else to be done
 		if (rb->velocity.Magnitude() == 0)
-			continue;
-		
-		// Update position as per velocity
-		bool didMove = rb->GetEntity()->Move(rb->velocity * (deltaTime / 1000.0f), rb->collider);
-		if (didMove)
 		{
-			// Apply drag / friction
-			// (This formula decreases velocity by drag percentage every second)
-			rb->velocity -= (rb->velocity * rb->drag) / (1000.0f / deltaTime);
+			UpdateSleepState(rb, deltaTime);
+			continue;
 		}
-		// Object didn't move, so there was a collision
-		else
+
+		movingBodies.push_back(rb);
+	}
+
+	BuildIslands(deltaTime);
+
+	JobSystem::Get().ParallelFor(islandCount, [this, deltaTime](size_t islandIdx) {
+		SimulateIsland(islands[islandIdx], deltaTime);
+	});
+
+	// Sleeping bodies resting on a body which moved off its spot lost their support
+	for (size_t i = 0; i < islandCount; i++)
+	{
+		const Island& island = islands[i];
+		for (size_t j = 0; j < island.bodies.size(); j++)
 		{
-			// Collision happens on object movement, so we have to move it first
-			Vector3 moveDelta = rb->velocity * (deltaTime / 1000.0f);
-			rb->GetEntity()->GetTransform().Translate(moveDelta);
-			rb->collider->Callibrate();  // Adjust collider after transform change
+			RigidBody* rb = island.bodies[j];
+			if (rb->collider != nullptr && rb->collider->GetColliderType() == BOX && rb->velocity.Magnitude() >= SLEEP_VELOCITY)
+				WakeBodiesTouching(island.startBoxes[j]);
+		}
+	}
+
+	// Log what the islands recorded, in island order
+	for (size_t i = 0; i < islandCount; i++)
+	{
+		for (const std::string& line : islands[i].logLines)
+			Logger::Get().Log(line);
+	}
 
-			// Get collision normal
-			Vector3 normal = CollisionSystem::Get().GetCollisionNormal(rb->collider);
+	// Merge the substep stats of all islands
+	lastSubstepStats = SubstepStats();
+	for (size_t i = 0; i < islandCount; i++)
+	{
+		const SubstepStats& stats = islands[i].substepStats;
+		lastSubstepStats.substeppedBodies += stats.substeppedBodies;
+		lastSubstepStats.totalSubsteps += stats.totalSubsteps;
+		lastSubstepStats.maxSubsteps = std::max(lastSubstepStats.maxSubsteps, stats.maxSubsteps);
+	}
+	if (logSubsteps && lastSubstepStats.substeppedBodies > 0)
+	{
+		Logger::Get().Log("Physics substeps: " + std::to_string(lastSubstepStats.substeppedBodies) + " bodies, " +
+			std::to_string(lastSubstepStats.totalSubsteps) + " steps, max " + std::to_string(lastSubstepStats.maxSubsteps));
+	}
 
-			if (normal.Magnitude() != 0)
+	// Keep the contacts for the next frame
+	UpdatePairCache();
+}
+
+void PhysicsSystem::ReportCollisions()
+{
+	// Report the collisions on the main thread. Islands & their collisions are always in the same order,
+	// so callbacks run in the same order no matter how the islands were scheduled.
+	for (size_t i = 0; i < islandCount; i++)
+	{
+		for (std::pair<Collider*, Collider*>& collision : islands[i].collisions)
+		{
+			// Getting hit wakes up a sleeping body & the bodies resting on it
+			RigidBody* otherRb = collision.second->GetRigidBody();
+			if (otherRb != nullptr && otherRb->isSleeping)
 			{
-				// Change velocity in the direction of collision's normal vector
-				if (normal.x != 0.0f)
-					rb->velocity.x = -rb->velocity.x * rb->resCoeff;
-				if (normal.y != 0.0f)
-					rb->velocity.y = -rb->velocity.y * rb->resCoeff;
-				if (normal.z != 0.0f)
-					rb->velocity.z = -rb->velocity.z * rb->resCoeff;
+				otherRb->WakeUp();
+				if (collision.second->GetColliderType() == BOX)
+					WakeBodiesTouching(static_cast<BoxCollider*>(collision.second)->boundingBox);
 			}
 
-			// Move the entity back & re-adjust the collider
-			rb->GetEntity()->GetTransform().position -= moveDelta;
-			rb->collider->Callibrate();
+			collision.first->OnCollisionEnter(collision.second);
+			collision.second->OnCollisionEnter(collision.first);
+		}
+	}
+}
+
+PhysicsSystem::PairKey PhysicsSystem::MakePairKey(Collider* a, Collider* b, bool& isFlipped)
+{
+	// Handles (unlike addresses) of removed colliders never match the colliders reusing their memory
+	RegistryHandle handleA = a->collisionHandle;
+	RegistryHandle handleB = b->collisionHandle;
+	isFlipped = handleB < handleA;
+	if (isFlipped)
+		std::swap(handleA, handleB);
+	return (static_cast<PairKey>(handleA) << 32) | handleB;
+}
+
+void PhysicsSystem::UpdatePairCache()
+{
+	++frameCount;
+
+	lastPairCacheStats = PairCacheStats();
+	for (size_t i = 0; i < islandCount; i++)
+	{
+		for (Contact& c : islands[i].contacts)
+		{
+			ContactPair& pair = pairCache[c.pairKey];
+			pair.normal = c.isKeyFlipped ? -c.normal : c.normal;
+			pair.normalImpulse = c.normalImpulse;
+			pair.lastFrame = frameCount;
+			// A body which fell asleep in this frame isn't simulated till it wakes up, so its pairs won't be refreshed
+			pair.sleeperHandle = INVALID_REGISTRY_HANDLE;
+			if (c.bodyA->isSleeping)
+				pair.sleeperHandle = c.bodyA->physicsHandle;
+			else if (c.bodyB != nullptr && c.bodyB->isSleeping)
+				pair.sleeperHandle = c.bodyB->physicsHandle;
+		}
+	}
+
+	// Drop the pairs which didn't touch in this frame. Pairs of sleeping bodies stay till the body wakes up.
+	for (auto itr = pairCache.begin(); itr != pairCache.end();)
+	{
+		if (itr->second.lastFrame == frameCount)
+		{
+			++itr;
+			continue;
+		}
+
+		RigidBody** sleeper = rigidBodies.Get(itr->second.sleeperHandle);
+		if (sleeper != nullptr && (*sleeper)->isSleeping)
+		{
+			++lastPairCacheStats.sleepingPairs;
+			++itr;
+		}
+		else
+		{
+			itr = pairCache.erase(itr);
+		}
+	}
+	lastPairCacheStats.cachedPairs = pairCache.size();
+}
+
+void PhysicsSystem::MoveKinematicBody(RigidBody* rb, float deltaTime)
+{
+	rb->instAcceleration.Reset();
+	if (!rb->hasKinematicTarget || deltaTime <= 0.0f)
+	{
+		rb->velocity.Reset();
+		return;
+	}
+	rb->hasKinematicTarget = false;
+
+	Transform& transform = rb->GetEntity()->GetTransform();
+	Vector3 moveDelta = rb->kinematicTarget;
+	moveDelta -= transform.position;
+	rb->velocity = moveDelta / (deltaTime / 1000.0f);
+	if (moveDelta.Magnitude() == 0.0f)
+		return;
+
+	transform.Translate(moveDelta);
+	if (rb->collider == nullptr || rb->collider->GetColliderType() != BOX)
+		return;
+
+	BoxCollider* boxC = static_cast<BoxCollider*>(rb->collider);
+	boxC->Translate(moveDelta);
+	CollisionSystem::Get().MarkColliderMoved(boxC);
+	// Bodies resting on it (or in its way) must move too
+	WakeBodiesTouching(boxC->boundingBox);
+}
+
+void PhysicsSystem::UpdateSleepState(RigidBody* rb, float deltaTime)
+{
+	if (rb->velocity.Magnitude() >= SLEEP_VELOCITY)
+	{
+		rb->restingTime = 0.0f;
+		return;
+	}
+
+	rb->restingTime += deltaTime / 1000.0f;
+	if (rb->restingTime >= SLEEP_TIME)
+	{
+		rb->isSleeping = true;
+		rb->velocity.Reset();
+	}
+}
+
+void PhysicsSystem::WakeBodiesTouching(const AABB& aabb)
+{
+	// Bodies resting on the AABB touch it but may not overlap it, so expand it a little
+	const float margin = 0.05f;
+
+	// Boxes of the woken bodies. Whatever rests on them lost its support too, so keep going up the stack.
+	std::vector<AABB> wokenBoxes;
+	std::vector<BoxCollider*> touching;
+	AABB source = aabb;
+	bool wakeAll = true;
+	while (true)
+	{
+		AABB expanded = source;
+		expanded.minCoords -= margin;
+		expanded.maxCoords += margin;
+
+		touching.clear();
+		CollisionSystem::Get().QueryOverlaps(expanded, touching);
+		for (BoxCollider* collider : touching)
+		{
+			RigidBody* rb = collider->GetRigidBody();
+			if (rb == nullptr || !rb->isSleeping)
+				continue;
+			// Past the first level, bodies below a woken body don't rest on it
+			if (!wakeAll && collider->boundingBox.minCoords.y <= source.minCoords.y)
+				continue;
+
+			rb->WakeUp();
+			wokenBoxes.push_back(collider->boundingBox);
+		}
+
+		if (wokenBoxes.empty())
+			break;
+		source = wokenBoxes.back();
+		wokenBoxes.pop_back();
+		wakeAll = false;
+	}
+}
+
+STRCODE PhysicsSystem::HashState(STRCODE hash) const
+{
+	for (RigidBody* rb : rigidBodies)
+	{
+		hash = HashBytes(&rb->velocity.x, 3 * sizeof(float), hash);
+		hash = HashBytes(&rb->isSleeping, sizeof(bool), hash);
+	}
+	return hash;
+}
+
+size_t PhysicsSystem::FindIslandRoot(size_t idx)
+{
+	while (islandParent[idx] != idx)
+	{
+		// Path halving
+		islandParent[idx] = islandParent[islandParent[idx]];
+		idx = islandParent[idx];
+	}
+	return idx;
+}
+
+void PhysicsSystem::MergeIslands(size_t a, size_t b)
+{
+	size_t rootA = FindIslandRoot(a);
+	size_t rootB = FindIslandRoot(b);
+	// Smaller index stays the root, so islands are ordered by their first body
+	if (rootA < rootB)
+		islandParent[rootB] = rootA;
+	else if (rootB < rootA)
+		islandParent[rootA] = rootB;
+}
+
+void PhysicsSystem::BuildIslands(float deltaTime)
+{
+	size_t numBodies = movingBodies.size();
+
+	sweptBoxes.resize(numBodies);
+	hasSweptBox.assign(numBodies, false);
+	islandParent.resize(numBodies);
+	if (bodyCandidates.size() < numBodies)
+		bodyCandidates.resize(numBodies);
+
+	colliderToBody.clear();
+	for (size_t i = 0; i < numBodies; i++)
+	{
+		islandParent[i] = i;
+		bodyCandidates[i].clear();
+
+		RigidBody* rb = movingBodies[i];
+		if (rb->collider == nullptr || rb->collider->GetColliderType() != BOX)
+			continue;
+
+		// The body can be anywhere between its current & next position in this frame
+		const AABB& box = static_cast<BoxCollider*>(rb->collider)->boundingBox;
+		Vector3 moveDelta = rb->velocity * (deltaTime / 1000.0f);
+		AABB& swept = sweptBoxes[i];
+		swept.minCoords.x = std::min(box.minCoords.x, box.minCoords.x + moveDelta.x);
+		swept.minCoords.y = std::min(box.minCoords.y, box.minCoords.y + moveDelta.y);
+		swept.minCoords.z = std::min(box.minCoords.z, box.minCoords.z + moveDelta.z);
+		swept.maxCoords.x = std::max(box.maxCoords.x, box.maxCoords.x + moveDelta.x);
+		swept.maxCoords.y = std::max(box.maxCoords.y, box.maxCoords.y + moveDelta.y);
+		swept.maxCoords.z = std::max(box.maxCoords.z, box.maxCoords.z + moveDelta.z);
+		hasSweptBox[i] = true;
+
+		colliderToBody[rb->collider] = i;
+	}
+
+	// Static colliders & colliders of resting bodies. Hitting a moving body puts both bodies in one island.
+	for (size_t i = 0; i < numBodies; i++)
+	{
+		if (!hasSweptBox[i])
+			continue;
+
+		CollisionSystem::Get().QueryOverlaps(sweptBoxes[i], bodyCandidates[i]);
+		for (BoxCollider* candidate : bodyCandidates[i])
+		{
+			auto itr = colliderToBody.find(candidate);
+			if (itr != colliderToBody.end())
+				MergeIslands(i, itr->second);
+		}
+	}
+
+	// Two moving bodies can meet even if neither of them overlaps the other's current position.
+	// Sweep their swept boxes along Z (direction of the game) to catch those.
+	std::vector<size_t> sortedBodies;
+	sortedBodies.reserve(numBodies);
+	for (size_t i = 0; i < numBodies; i++)
+	{
+		if (hasSweptBox[i])
+			sortedBodies.push_back(i);
+	}
+	std::sort(sortedBodies.begin(), sortedBodies.end(), [this](size_t a, size_t b) {
+		return sweptBoxes[a].minCoords.z < sweptBoxes[b].minCoords.z;
+	});
+	for (size_t i = 0; i < sortedBodies.size(); i++)
+	{
+		const AABB& first = sweptBoxes[sortedBodies[i]];
+		for (size_t j = i + 1; j < sortedBodies.size(); j++)
+		{
+			const AABB& second = sweptBoxes[sortedBodies[j]];
+			if (second.minCoords.z > first.maxCoords.z)
+				break;
+			if (first.Intersects(second))
+				MergeIslands(sortedBodies[i], sortedBodies[j]);
+		}
+	}
+
+	// Create the islands. Roots are the smallest index of their island, so visiting bodies in order
+	// creates islands in order of their first body.
+	std::vector<size_t> rootToIsland(numBodies, SIZE_MAX);
+	islandCount = 0;
+	for (size_t i = 0; i < numBodies; i++)
+	{
+		size_t root = FindIslandRoot(i);
+		if (rootToIsland[root] == SIZE_MAX)
+		{
+			rootToIsland[root] = islandCount++;
+			if (islands.size() < islandCount)
+				islands.resize(islandCount);
+
+			Island& island = islands[islandCount - 1];
+			island.bodies.clear();
+			island.candidates.clear();
+			island.collisions.clear();
+			island.logLines.clear();
+			island.substepStats = SubstepStats();
 		}
+		islands[rootToIsland[root]].bodies.push_back(movingBodies[i]);
+	}
+
+	// Collect the candidates of each island. Bodies of an island can also hit each other.
+	std::unordered_set<BoxCollider*> seen;
+	for (size_t i = 0; i < numBodies; i++)
+	{
+		if (!hasSweptBox[i])
+			continue;
+
+		Island& island = islands[rootToIsland[FindIslandRoot(i)]];
+		island.candidates.push_back(static_cast<BoxCollider*>(movingBodies[i]->collider));
+		for (BoxCollider* candidate : bodyCandidates[i])
+			island.candidates.push_back(candidate);
+	}
+	for (size_t i = 0; i < islandCount; i++)
+	{
+		// Remove duplicates without changing the order
+		std::vector<BoxCollider*>& candidates = islands[i].candidates;
+		seen.clear();
+		candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&seen](BoxCollider* c) {
+			return !seen.insert(c).second;
+		}), candidates.end());
+	}
+}
+
+void PhysicsSystem::SimulateIsland(Island& island, float deltaTime)
+{
+	island.startBoxes.resize(island.bodies.size());
+	for (size_t i = 0; i < island.bodies.size(); i++)
+	{
+		RigidBody* rb = island.bodies[i];
+		rb->solverIndex = static_cast<int>(i);
+		if (rb->collider != nullptr && rb->collider->GetColliderType() == BOX)
+			island.startBoxes[i] = static_cast<BoxCollider*>(rb->collider)->boundingBox;
+
+		// Update position as per velocity
+		IntegratePosition(rb, island, deltaTime);
+	}
+
+	FindContacts(island);
+	SolveContacts(island);
+	CorrectPositions(island);
+
+	for (RigidBody* rb : island.bodies)
+	{
+		// Apply drag
+		// (This formula decreases velocity by drag percentage every second)
+		rb->velocity -= (rb->velocity * rb->drag) / (1000.0f / deltaTime);
 
 		// To prevent unusual behavior
 		if (rb->velocity.Magnitude() < 0.1f)
 			rb->velocity.Reset();
+
+		UpdateSleepState(rb, deltaTime);
+		rb->solverIndex = -1;
+	}
+}
+
+void PhysicsSystem::IntegratePosition(RigidBody* rb, Island& island, float deltaTime)
+{
+	Vector3 moveDelta = rb->velocity * (deltaTime / 1000.0f);
+	Transform& transform = rb->GetEntity()->GetTransform();
+
+	if (rb->collider == nullptr || rb->collider->GetColliderType() != BOX)
+	{
+		transform.Translate(moveDelta);
+		return;
+	}
+
+	// Number of steps depends on how far the body moves compared to its own size
+	BoxCollider* boxC = static_cast<BoxCollider*>(rb->collider);
+	const AABB& box = boxC->boundingBox;
+	float minExtent = std::min(box.maxCoords.x - box.minCoords.x, std::min(box.maxCoords.y - box.minCoords.y, box.maxCoords.z - box.minCoords.z));
+	float maxStepLength = substepFraction * minExtent;
+	int substeps = 1;
+	if (maxStepLength > 0.0f)
+	{
+		float steps = std::ceil(moveDelta.Magnitude() / maxStepLength);
+		substeps = static_cast<int>(std::max(1.0f, std::min(steps, static_cast<float>(maxSubsteps))));
+	}
+
+	// Slow bodies (almost all of them) take a single step
+	if (substeps == 1)
+	{
+		transform.Translate(moveDelta);
+		CallibrateCollider(rb, island);  // Adjust collider after transform change
+		return;
+	}
+
+	++island.substepStats.substeppedBodies;
+	island.substepStats.totalSubsteps += substeps;
+	island.substepStats.maxSubsteps = std::max(island.substepStats.maxSubsteps, substeps);
+
+	// Contacts that already exist are left to the solver. Stop only when something new is hit.
+	std::vector<bool>& overlappedAtStart = island.overlappedAtStart;
+	overlappedAtStart.assign(island.candidates.size(), false);
+	for (size_t i = 0; i < island.candidates.size(); i++)
+	{
+		overlappedAtStart[i] = (island.candidates[i] != boxC) && box.Intersects(island.candidates[i]->boundingBox);
+	}
+
+	Vector3 stepDelta = moveDelta / static_cast<float>(substeps);
+	for (int step = 0; step < substeps; step++)
+	{
+		transform.Translate(stepDelta);
+		CallibrateCollider(rb, island);
+
+		for (size_t i = 0; i < island.candidates.size(); i++)
+		{
+			BoxCollider* candidate = island.candidates[i];
+			if (candidate != boxC && !overlappedAtStart[i] && box.Intersects(candidate->boundingBox))
+				return;
+		}
+	}
+}
+
+void PhysicsSystem::FindContacts(Island& island)
+{
+	island.contacts.clear();
+	for (RigidBody* rb : island.bodies)
+	{
+		if (rb->collider == nullptr || rb->collider->GetColliderType() != BOX)
+			continue;
+
+		BoxCollider* boxC = static_cast<BoxCollider*>(rb->collider);
+		for (BoxCollider* candidate : island.candidates)
+		{
+			if (candidate == boxC)
+				continue;
+
+			// Bodies of other islands never show up here, and resting (or sleeping) bodies are treated as static
+			RigidBody* other = candidate->GetRigidBody();
+			bool otherSimulated = (other != nullptr && other->solverIndex >= 0);
+			// A contact between two simulated bodies is found from both sides. Keep just one.
+			if (otherSimulated && other->solverIndex < rb->solverIndex)
+				continue;
+
+			// Cheap rejection first. Only touching pairs need a contact.
+			if (!boxC->boundingBox.Intersects(candidate->boundingBox))
+				continue;
+
+			Contact contact;
+			if (!boxC->boundingBox.GetPenetration(candidate->boundingBox, contact.normal, contact.depth))
+				continue;
+
+			// The pair cache is only read here (it gets updated after all islands are done)
+			contact.pairKey = MakePairKey(boxC, candidate, contact.isKeyFlipped);
+			auto itr = pairCache.find(contact.pairKey);
+			if (itr != pairCache.end())
+			{
+				contact.wasTouching = true;
+				contact.cachedNormal = contact.isKeyFlipped ? -itr->second.normal : itr->second.normal;
+				contact.cachedImpulse = itr->second.normalImpulse;
+			}
+
+			contact.colliderA = boxC;
+			contact.colliderB = candidate;
+			contact.bodyA = rb;
+			contact.bodyB = otherSimulated ? other : nullptr;
+			if (other != nullptr && other->isKinematic)
+				contact.kinematicVelocityB = other->velocity;
+			island.contacts.push_back(contact);
+
+			// Pairs which touched in the last frame are still in the cache. Only new pairs get reported.
+			if (!contact.wasTouching)
+				island.collisions.push_back({ boxC, candidate });
+		}
+	}
+}
+
+void PhysicsSystem::SolveContacts(Island& island)
+{
+	for (Contact& c : island.contacts)
+	{
+		RigidBody* a = c.bodyA;
+		RigidBody* b = c.bodyB;
+
+		c.invMassA = (a->mass > 0.0f) ? 1.0f / a->mass : 0.0f;
+		c.invMassB = (b != nullptr && b->mass > 0.0f) ? 1.0f / b->mass : 0.0f;
+
+		Vector3 relVelocity = (b != nullptr) ? a->velocity - b->velocity : a->velocity - c.kinematicVelocityB;
+		float normalVelocity = Vector3::Dot(relVelocity, c.normal);
+
+		// Restitution is applied only on actual hits, resting contacts must not bounce
+		float resCoeff = (b != nullptr) ? std::max(a->resCoeff, b->resCoeff) : a->resCoeff;
+		c.bounceVelocity = (normalVelocity < -BOUNCE_THRESHOLD) ? -resCoeff * normalVelocity : 0.0f;
+
+		c.friction = (b != nullptr) ? std::sqrt(a->friction * b->friction) : a->friction;
+		c.tangent = relVelocity - c.normal * normalVelocity;
+		if (c.tangent.Magnitude() > 0.0001f)
+			c.tangent.Normalize();
+		else
+			c.tangent.Reset();
+
+		c.normalImpulse = 0.0f;
+		c.tangentImpulse = 0.0f;
+		if (warmStarting)
+		{
+			// Last frame's impulse is useless if the contact turned around
+			if (c.wasTouching && c.cachedImpulse > 0.0f && Vector3::Dot(c.cachedNormal, c.normal) > 0.9f)
+			{
+				c.normalImpulse = c.cachedImpulse;
+				Vector3 impulse = c.normal * c.normalImpulse;
+				a->velocity += impulse * c.invMassA;
+				if (b != nullptr)
+					b->velocity -= impulse * c.invMassB;
+			}
+		}
+	}
+
+	for (int iteration = 0; iteration < solverIterations; iteration++)
+	{
+		for (Contact& c : island.contacts)
+		{
+			RigidBody* a = c.bodyA;
+			RigidBody* b = c.bodyB;
+			float invMassSum = c.invMassA + c.invMassB;
+			if (invMassSum == 0.0f)
+				continue;
+
+			// Normal impulse. Accumulated impulse can't be negative (contacts can only push).
+			Vector3 relVelocity = (b != nullptr) ? a->velocity - b->velocity : a->velocity - c.kinematicVelocityB;
+			float lambda = (c.bounceVelocity - Vector3::Dot(relVelocity, c.normal)) / invMassSum;
+			float oldImpulse = c.normalImpulse;
+			c.normalImpulse = std::max(oldImpulse + lambda, 0.0f);
+			Vector3 impulse = c.normal * (c.normalImpulse - oldImpulse);
+			a->velocity += impulse * c.invMassA;
+			if (b != nullptr)
+				b->velocity -= impulse * c.invMassB;
+
+			// Friction impulse. Limited by the normal impulse (Coulomb's law).
+			if (c.tangent.Magnitude() == 0.0f)
+				continue;
+			relVelocity = (b != nullptr) ? a->velocity - b->velocity : a->velocity - c.kinematicVelocityB;
+			lambda = -Vector3::Dot(relVelocity, c.tangent) / invMassSum;
+			float maxFriction = c.friction * c.normalImpulse;
+			oldImpulse = c.tangentImpulse;
+			c.tangentImpulse = std::max(-maxFriction, std::min(oldImpulse + lambda, maxFriction));
+			impulse = c.tangent * (c.tangentImpulse - oldImpulse);
+			a->velocity += impulse * c.invMassA;
+			if (b != nullptr)
+				b->velocity -= impulse * c.invMassB;
+		}
+	}
+}
+
+void PhysicsSystem::CorrectPositions(Island& island)
+{
+	for (Contact& c : island.contacts)
+	{
+		float invMassSum = c.invMassA + c.invMassB;
+		float penetration = c.depth - penetrationSlop;
+		if (invMassSum == 0.0f || penetration <= 0.0f)
+			continue;
+
+		// Heavier body moves less
+		Vector3 correction = c.normal * (penetration * positionCorrection / invMassSum);
+		c.bodyA->GetEntity()->GetTransform().Translate(correction * c.invMassA);
+		if (c.bodyB != nullptr)
+			c.bodyB->GetEntity()->GetTransform().Translate(-correction * c.invMassB);
+	}
+
+	for (RigidBody* rb : island.bodies)
+	{
+		if (rb->collider != nullptr)
+			CallibrateCollider(rb, island);
+	}
+}
+
+void PhysicsSystem::CallibrateCollider(RigidBody* rb, Island& island)
+{
+	// BoxCollider::Callibrate would log the failure from this worker thread
+	if (rb->collider->GetColliderType() == BOX && static_cast<BoxCollider*>(rb->collider)->meshR == nullptr)
+	{
+		island.logLines.push_back("No mesh renderer found! Box collider callibration failed.");
+		return;
 	}
+	rb->collider->Callibrate();
 }
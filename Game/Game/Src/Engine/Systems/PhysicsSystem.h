@@ -6,24 +6,254 @@
 #ifndef _PHYSICS_SYSTEM_H_
 #define _PHYSICS_SYSTEM_H_
 
+#include "Engine/Algorithms/AABB.h"
+#include "Engine/Core/DenseRegistry.h"
+
 class RigidBody;
+class Collider;
+class BoxCollider;
+
+// Substepping statistics of a frame. Useful for tuning the substep fraction.
+struct SubstepStats
+{
+	// Bodies which needed more than 1 step
+	size_t substeppedBodies = 0;
+	// Steps taken by those bodies
+	size_t totalSubsteps = 0;
+	int maxSubsteps = 0;
+};
+
+// Contact pair cache statistics of a frame
+struct PairCacheStats
+{
+	// Pairs kept in the cache
+	size_t cachedPairs = 0;
+	// Pairs kept only because one of their bodies is asleep
+	size_t sleepingPairs = 0;
+};
 
 class PhysicsSystem
 {
 	DECLARE_SINGLETON(PhysicsSystem)
-	
+
+	// Key of a collider pair made of both collision handles, smaller handle first
+	using PairKey = unsigned long long;
+
+	// Contact data kept between frames for a pair of touching colliders
+	struct ContactPair
+	{
+		// Pushes the first collider of the key away from the second
+		Vector3 normal;
+		// Accumulated normal impulse of the last frame, used for warm starting
+		float normalImpulse = 0.0f;
+		// Pairs not touching in the current frame get dropped, unless one of the bodies fell asleep on the other
+		unsigned int lastFrame = 0;
+		// Body which fell asleep while touching. The pair is kept till it wakes up, so that it starts
+		// with its old impulse & doesn't report the contact as new.
+		RegistryHandle sleeperHandle = INVALID_REGISTRY_HANDLE;
+	};
+
+	// Contact between a simulated body (A) and another collider (B)
+	struct Contact
+	{
+		BoxCollider* colliderA = nullptr;
+		BoxCollider* colliderB = nullptr;
+		RigidBody* bodyA = nullptr;
+		// Null if B is static (or not simulated in this frame)
+		RigidBody* bodyB = nullptr;
+
+		// Direction in which A must be pushed to separate it from B
+		Vector3 normal;
+		float depth = 0.0f;
+
+		float invMassA = 0.0f;
+		float invMassB = 0.0f;
+		// Velocity of B if it is kinematic. It pushes A, but A can't push it back.
+		Vector3 kinematicVelocityB;
+		// Target separating velocity due to restitution
+		float bounceVelocity = 0.0f;
+		float friction = 0.0f;
+		Vector3 tangent;
+
+		// Impulses accumulated over the solver iterations
+		float normalImpulse = 0.0f;
+		float tangentImpulse = 0.0f;
+
+		PairKey pairKey = 0;
+		// Is A the second collider of the key?
+		bool isKeyFlipped = false;
+		// Cached pair of the last frame, read once in FindContacts. Pushes A away from B.
+		bool wasTouching = false;
+		Vector3 cachedNormal;
+		float cachedImpulse = 0.0f;
+	};
+
+	/**
+	 * An island is a group of rigid bodies that can touch each other in the current frame.
+	 * Bodies of different islands never interact, so islands are simulated in parallel.
+	 */
+	struct Island
+	{
+		// Sorted in the order they are stored in the physics system
+		std::vector<RigidBody*> bodies;
+		// All the colliders that bodies of this island can hit in the current frame
+		std::vector<BoxCollider*> candidates;
+		// Collision callbacks can't run on worker threads (they spawn & remove entities),
+		// so collisions get recorded here & reported after the simulation.
+		// Only pairs which didn't touch in the last frame are recorded.
+		std::vector<std::pair<Collider*, Collider*>> collisions;
+		// Contacts of the current frame, solved together
+		std::vector<Contact> contacts;
+		// Boxes of the bodies before they moved in the current frame
+		std::vector<AABB> startBoxes;
+		// Scratch data for substepping: did the body overlap a candidate before moving?
+		std::vector<bool> overlappedAtStart;
+		// The logger isn't thread-safe, so messages get recorded here & logged after the simulation
+		std::vector<std::string> logLines;
+		SubstepStats substepStats;
+	};
+
+	// ---------------- Contact solver settings ----------------
+	int solverIterations = 8;
+	// Start with the impulses of the previous frame (resting contacts settle much faster)
+	bool warmStarting = true;
+	// Fraction of penetration removed in a frame
+	float positionCorrection = 0.8f;
+	// Penetration allowed without correction. Keeps resting contacts from jittering.
+	float penetrationSlop = 0.01f;
+	// Bodies hitting slower than this (units/second) don't bounce
+	const float BOUNCE_THRESHOLD = 1.0f;
+
+	// ---------------- Substepping settings ----------------
+	// A body moving more than this fraction of its smallest extent in a frame gets substepped
+	float substepFraction = 0.5f;
+	int maxSubsteps = 16;
+	bool logSubsteps = false;
+	SubstepStats lastSubstepStats;
+
+	// A body moving slower than SLEEP_VELOCITY for SLEEP_TIME seconds goes to sleep
+	const float SLEEP_VELOCITY = 0.2f;
+	const float SLEEP_TIME = 0.5f;
+
 	float gravity = 0;
-	std::list<RigidBody*> rigidBodies;
+	DenseRegistry<RigidBody*> rigidBodies;
+
+	// ---------------- Per-frame data (kept around to avoid re-allocations) ----------------
+	std::vector<RigidBody*> movingBodies;
+	// AABB covering a moving body's collider at both its start & end position
+	std::vector<AABB> sweptBoxes;
+	std::vector<bool> hasSweptBox;
+	std::vector<std::vector<BoxCollider*>> bodyCandidates;
+	std::unordered_map<Collider*, size_t> colliderToBody;
+	// Union-find parent of every moving body
+	std::vector<size_t> islandParent;
+	std::vector<Island> islands;
+	size_t islandCount = 0;
+
+	// Every pair of touching colliders of the last frame, plus the pairs of sleeping bodies.
+	// Read-only while the islands are simulated, updated once all of them are done.
+	std::unordered_map<PairKey, ContactPair> pairCache;
+	unsigned int frameCount = 0;
+	PairCacheStats lastPairCacheStats;
+
+	static PairKey MakePairKey(Collider* a, Collider* b, bool& isFlipped);
+
+	/**
+	 * @brief Store the contacts of all islands in the pair cache & drop the pairs which stopped touching.
+	 * Pairs of bodies which are asleep are kept till the bodies wake up.
+	 */
+	void UpdatePairCache();
+
+	size_t FindIslandRoot(size_t);
+	void MergeIslands(size_t, size_t);
+
+	/**
+	 * @brief Move a kinematic body to the position its script asked for.
+	 * Its box is moved along without going through its mesh again, & checked directly by the broadphase
+	 * till the next BVH update.
+	 */
+	void MoveKinematicBody(RigidBody* rb, float deltaTime);
+
+	/**
+	 * @brief Group the moving bodies into islands using the broadphase.
+	 */
+	void BuildIslands(float deltaTime);
+
+	/**
+	 * @brief Move all bodies of an island & resolve their contacts.
+	 * Runs on a worker thread, so it must touch only the data of this island.
+	 */
+	void SimulateIsland(Island& island, float deltaTime);
+
+	/**
+	 * @brief Move a body as per its velocity.
+	 * Fast bodies move in substeps & stop at the first new overlap so that they can't tunnel.
+	 */
+	void IntegratePosition(RigidBody* rb, Island& island, float deltaTime);
+
+	/**
+	 * @brief Reconstruct the collider of an island body after it moved.
+	 * A box without a mesh renderer can't be callibrated. That gets recorded in the island's log lines.
+	 */
+	void CallibrateCollider(RigidBody* rb, Island& island);
+
+	/**
+	 * @brief Find all contacts of the island bodies at their current position.
+	 */
+	void FindContacts(Island& island);
+
+	/**
+	 * @brief Sequential impulse solver. Resolves all contacts of the island together.
+	 */
+	void SolveContacts(Island& island);
+
+	/**
+	 * @brief Push penetrating bodies apart.
+	 */
+	void CorrectPositions(Island& island);
+
+	/**
+	 * @brief Put the body to sleep if it has been still for long enough.
+	 */
+	void UpdateSleepState(RigidBody* rb, float deltaTime);
 
 public:
 	void SetGravity(float g) { gravity = g; }
+	float GetGravity() const { return gravity; }
+	void SetSolverIterations(int iterations) { solverIterations = std::max(1, iterations); }
+	void SetWarmStarting(bool enable) { warmStarting = enable; }
+	void SetPositionCorrection(float fraction, float slop) { positionCorrection = fraction; penetrationSlop = slop; }
+	void SetSubstepping(float fraction, int maxSteps) { substepFraction = fraction; maxSubsteps = std::max(1, maxSteps); }
+	void SetLogSubsteps(bool enable) { logSubsteps = enable; }
+	const SubstepStats& GetLastFrameSubstepStats() const { return lastSubstepStats; }
+	const PairCacheStats& GetLastFramePairCacheStats() const { return lastPairCacheStats; }
 
 	void AddRigidBody(RigidBody*);
 	void RemoveRigidBody(RigidBody*);
 
+	/**
+	 * @brief Wake up the sleeping bodies touching an AABB, along with the sleeping bodies stacked on them.
+	 * Must be called when something they could be resting on goes away.
+	 */
+	void WakeBodiesTouching(const AABB& aabb);
+
+	/**
+	 * @brief Hash the velocity & sleep state of all rigid bodies.
+	 *
+	 * @param hash Hash to continue from.
+	 */
+	STRCODE HashState(STRCODE hash) const;
+
 protected:
+	/**
+	 * @brief Simulate the rigid bodies. Collisions are only collected, see ReportCollisions.
+	 */
 	void Update(float);
-	
+	/**
+	 * @brief Call the collision callbacks of the last Update. Runs game code, so it must be on the main thread.
+	 */
+	void ReportCollisions();
+
 	friend class Engine;
 };
 
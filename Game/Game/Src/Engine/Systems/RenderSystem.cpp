@@ -6,6 +6,7 @@
 #include "app/app.h"
 
 #include "Engine/Systems/RenderSystem.h"
+#include "Engine/Systems/DebrisSystem.h"
 #include "Engine/Core/Logger.h"
 #include "Engine/Components/Renderable.h"
 #include "Engine/Components/Entity.h"
@@ -13,16 +14,15 @@
 
 void RenderSystem::AddRenderable(Renderable* renderable)
 {
-	// Pushing in front so that the entities added later get rendered first
-	// This ensures that older entities are in front
-	renderables.push_front(renderable);
+	renderable->renderHandle = renderables.Add(renderable);
 	uidToRenderable[renderable->GetUid()] = renderable;
 }
 
 void RenderSystem::RemoveRenderable(Renderable* renderable)
 {
 	uidToRenderable.erase(renderable->GetUid());
-	renderables.remove(renderable);
+	renderables.Remove(renderable->renderHandle);
+	renderable->renderHandle = INVALID_REGISTRY_HANDLE;
 }
 
 Renderable* RenderSystem::GetRenderable(STRCODE id)
@@ -76,8 +76,15 @@ void RenderSystem::Render()
 	// Update view matrix (to be used in renderables)
 	viewMatrix = Matrix4x4::CreateLookAt(cameraPosition, cameraTarget, Vector3(0.0f, 1.0f, 0.0f));
 
-	for (Renderable* renderable : renderables)
+	// Debris is always newer than the renderables, so it goes first
+	DebrisSystem::Get().Render();
+
+	// Rendering back to front so that the entities added later get rendered first
+	// This ensures that older entities are in front. Removal only moves the newest entity,
+	// so the long-living entities (UI etc.) keep their place at the start.
+	for (size_t i = renderables.Size(); i-- > 0;)
 	{
+		Renderable* renderable = renderables[i];
 		if (renderable->IsActive())
 		{
 			renderable->Render();
@@ -9,6 +9,7 @@
 
 #include "Engine/Math/Vector3.h"
 #include "Engine/Math/Matrix4x4.h"
+#include "Engine/Core/DenseRegistry.h"
 
 class Renderable;
 
@@ -19,8 +20,7 @@ class RenderSystem
 private:
 	float cameraSpeed = 0.4f;
 
-	std::list<Renderable*> renderables;
-	std::list<Renderable*> renderablesToBeRemoved;
+	DenseRegistry<Renderable*> renderables;
 	std::map<STRCODE, Renderable*> uidToRenderable;
 
 	Renderable* GetRenderable(STRCODE);
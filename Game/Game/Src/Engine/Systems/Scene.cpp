@@ -5,10 +5,17 @@
 #include "stdafx.h"
 #include "Engine/Systems/Scene.h"
 #include "Engine/Systems/SceneManager.h"
+#include "Engine/Systems/DebrisSystem.h"
 #include "Engine/Components/Entity.h"
 #include "Engine/Core/Logger.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Pools/EntityPool.h"
 
+// Order given to the commands deferred by the component being updated on this thread (see Scene::Defer).
+// NOT_IN_PARALLEL_UPDATE outside of UpdateComponentsInParallel.
+static const unsigned long long NOT_IN_PARALLEL_UPDATE = ~0ull;
+static thread_local unsigned long long deferredCommandOrder = NOT_IN_PARALLEL_UPDATE;
+
 Scene::Scene()
 {
 	UUID _guid;
@@ -34,29 +41,55 @@ void Scene::Load()
 	}
 }
 
+void Scene::TrackEntity(Entity* entity)
+{
+	entity->scene = this;
+	entity->sceneHandle.value = entities.Add(entity);
+	entitiesByUid[entity->GetUid()] = entity;
+	entitiesByName[entity->name].push_back(entity);
+	for (int type = 0; type < COMPONENT_TYPE_COUNT; type++)
+	{
+		if (entity->componentMask & ComponentTypeBit(static_cast<ComponentType>(type)))
+			AddToComponentView(entity, static_cast<ComponentType>(type));
+	}
+}
+
+void Scene::RemoveFromNameIndex(Entity* entity)
+{
+	auto it = entitiesByName.find(entity->name);
+	if (it == entitiesByName.end())
+		return;
+
+	std::vector<Entity*>& named = it->second;
+	auto entityIt = std::find(named.begin(), named.end(), entity);
+	if (entityIt != named.end())
+	{
+		*entityIt = named.back();
+		named.pop_back();
+	}
+	if (named.empty())
+		entitiesByName.erase(it);
+}
+
 void Scene::Initialize()
 {
-	// Initialize happens before first PreUpdate. So it must be called on entitiesToBeAdded
-	for (Entity* entity : entitiesToBeAdded)
+	// Initialize happens before first PreUpdate. Entities are tracked as soon as they are created.
+	for (Entity* entity : entities)
 	{
 		entity->Initialize();
 	}
-	std::string logMsg = "Scene (name=" + name + ", GUID=" + guid + ") initialized with " + std::to_string(entitiesToBeAdded.size()) + " entities.";
+	std::string logMsg = "Scene (name=" + name + ", GUID=" + guid + ") initialized with " + std::to_string(entities.Size()) + " entities.";
 	Logger::Get().Log(logMsg);
 }
 
 void Scene::PreUpdate()
 {
-	for (Entity* entity : entitiesToBeAdded)
-	{
-		entities.push_back(entity);
-	}
-	entitiesToBeAdded.clear();
-
 	// Call pre update on all entites
 	// Useful for adding any components scheduled to be added
-	for (Entity* entity : entities)
+	// Entities can get created in the loop, so it goes by index. New ones are at the back & wait for the next frame.
+	for (size_t i = 0, count = entities.Size(); i < count; i++)
 	{
+		Entity* entity = entities[i];
 		if (entity->IsActive())
 		{
 			entity->PreUpdate();
@@ -66,8 +99,20 @@ void Scene::PreUpdate()
 
 void Scene::Update(float deltaTime)
 {
-	for (Entity* entity : entities)
+	// Parallel-safe components first, one type at a time, so they only ever run alongside their own kind.
+	// They all run before any serial component of the frame: within a frame, a parallel-safe component sees the
+	// state the serial ones left in the previous frame (a DoorOpener moves its door before the player updates).
+	// Entities created by the serial updates below aren't in the views yet & wait for the next frame.
+	for (int type = 0; type < COMPONENT_TYPE_COUNT; type++)
+	{
+		if (parallelComponentTypes & ComponentTypeBit(static_cast<ComponentType>(type)))
+			UpdateComponentsInParallel(static_cast<ComponentType>(type), deltaTime);
+	}
+	PlayDeferredCommands();
+
+	for (size_t i = 0, count = entities.Size(); i < count; i++)
 	{
+		Entity* entity = entities[i];
 		if (entity->IsActive())
 		{
 			entity->Update(deltaTime);
@@ -75,21 +120,74 @@ void Scene::Update(float deltaTime)
 	}
 }
 
+void Scene::UpdateComponentsInParallel(ComponentType componentType, float deltaTime)
+{
+	// A buffer for every thread which can take part
+	if (deferredCommands.size() < JobSystem::Get().GetWorkerCount() + 1)
+		deferredCommands.resize(JobSystem::Get().GetWorkerCount() + 1);
+
+	const DenseRegistry<Entity*>& view = componentViews[componentType];
+	JobSystem::Get().ParallelFor(view.Size(), [&view, componentType, deltaTime](size_t i) {
+		Entity* entity = view[i];
+		if (!entity->IsActive())
+			return;
+
+		// Every component of the type, not just the first one. Like Entity::Update, the ones added this frame wait.
+		for (Component* component : entity->components)
+		{
+			if (component->GetType() == componentType && component->IsActive() && component->IsParallelSafe())
+			{
+				// Type first, then position in the view: the order the entities would have been updated in on one thread
+				deferredCommandOrder = (static_cast<unsigned long long>(componentType) << 32) | i;
+				component->Update(deltaTime);
+				deferredCommandOrder = NOT_IN_PARALLEL_UPDATE;
+			}
+		}
+	});
+}
+
+void Scene::PlayDeferredCommands()
+{
+	std::vector<DeferredCommand> commands;
+	for (std::vector<DeferredCommand>& buffer : deferredCommands)
+	{
+		for (DeferredCommand& command : buffer)
+			commands.push_back(std::move(command));
+		buffer.clear();
+	}
+	if (commands.empty())
+		return;
+
+	// Stable, so the commands of one component stay in the order it made them
+	std::stable_sort(commands.begin(), commands.end(), [](const DeferredCommand& a, const DeferredCommand& b) {
+		return a.order < b.order;
+	});
+	for (DeferredCommand& command : commands)
+	{
+		command.func();
+	}
+}
+
 void Scene::PostUpdate()
 {
+	// Commands of the components updated in parallel by engine systems (particles)
+	PlayDeferredCommands();
+
 	// Call post update on all entites
 	// Useful for deleting any components scheduled to be deleted
-	for (Entity* entity : entities)
+	for (size_t i = 0, count = entities.Size(); i < count; i++)
 	{
+		Entity* entity = entities[i];
 		if (entity->IsActive())
 		{
 			entity->PostUpdate();
 		}
 	}
 
-	for (Entity* entity : entitiesToUntrack)
+	// Entities don't move before this, so pointers taken during the frame stay valid till here
+	for (EntityHandle handle : entitiesToUntrack)
 	{
-		entities.remove(entity);
+		entities.Remove(handle.value);
 	}
 	entitiesToUntrack.clear();
 
@@ -115,14 +213,23 @@ void Scene::Destroy()
 	{
 		entity->sourcePool->MarkObjectAsFree(static_cast<Object*>(entity));
 	}
-	entities.clear();
-	// Ensure nothing is scheduled to be added or removed
-	for (Entity* entity : entitiesToBeAdded)
+	entities.Clear();
+	entitiesByUid.clear();
+	entitiesByName.clear();
+	for (DenseRegistry<Entity*>& view : componentViews)
 	{
-		entity->sourcePool->MarkObjectAsFree(static_cast<Object*>(entity));
+		view.Clear();
 	}
-	entitiesToBeAdded.clear();
+	// Ensure nothing is scheduled to be removed
 	entitiesToUntrack.clear();
+	parallelComponentTypes = 0;
+	for (std::vector<DeferredCommand>& buffer : deferredCommands)
+	{
+		buffer.clear();
+	}
+
+	// Debris of the old scene must not fly around in the new one
+	DebrisSystem::Get().Clear();
 }
 
 void Scene::ReloadScene()
@@ -134,13 +241,37 @@ void Scene::ReloadScene()
 Entity* Scene::CreateEntity(std::vector<ComponentType>& components)
 {
 	Entity* entity = SceneManager::Get().GetNewEntity(components);
-	entitiesToBeAdded.push_back(entity);
+	TrackEntity(entity);
 	return entity;
 }
 
+void Scene::CreateEntities(std::vector<ComponentType>& components, size_t count, std::vector<Entity*>& result)
+{
+	size_t first = result.size();
+	SceneManager::Get().GetNewEntities(components, count, result);
+	for (size_t i = first; i < result.size(); i++)
+	{
+		TrackEntity(result[i]);
+	}
+}
+
 void Scene::AddDanglingEntity(Entity* entity)
 {
-	entitiesToBeAdded.push_back(entity);
+	if (!entity->sceneHandle.IsNull())
+	{
+		Logger::Get().Log("Entity " + entity->GetName() + " is already part of a scene.", WARNING_LOG);
+		return;
+	}
+	TrackEntity(entity);
+}
+
+Entity* Scene::GetEntity(EntityHandle handle) const
+{
+	Entity* const* entity = entities.Get(handle.value);
+	// The handle of an entity is reset on removal, so a pooled entity won't answer to its old handle
+	if (entity == nullptr || (*entity)->sceneHandle != handle)
+		return nullptr;
+	return *entity;
 }
 
 Entity* Scene::FindEntity(const std::string& entityGUID) const
@@ -150,88 +281,154 @@ Entity* Scene::FindEntity(const std::string& entityGUID) const
 
 Entity* Scene::FindEntity(STRCODE entityId) const
 {
-	for (Entity* entity : entities)
-	{
-		if (entity->GetUid() == entityId)
-		{
-			return entity;
-		}
-	}
-	// Maybe the entity is yet to be added
-	for (Entity* entity : entitiesToBeAdded)
-	{
-		if (entity->GetUid() == entityId)
-		{
-			return entity;
-		}
-	}
-	return nullptr;
+	auto it = entitiesByUid.find(entityId);
+	if (it == entitiesByUid.end())
+		return nullptr;
+	return it->second;
 }
 
-std::list<Entity*> Scene::FindEntityByName(const std::string& entityName) const
+const std::vector<Entity*>& Scene::FindEntityByName(const std::string& entityName) const
 {
-	std::list<Entity*> foundEntities;
-	for (Entity* entity : entities)
-	{
-		if (entity->GetName() == entityName)
-		{
-			foundEntities.push_back(entity);
-		}
-	}
-	// Maybe the entity is yet to be added
-	for (Entity* entity : entitiesToBeAdded)
-	{
-		if (entity->GetName() == entityName)
-		{
-			foundEntities.push_back(entity);
-		}
-	}
-	return foundEntities;
+	static const std::vector<Entity*> noEntities;
+	auto it = entitiesByName.find(entityName);
+	if (it == entitiesByName.end())
+		return noEntities;
+	return it->second;
 }
 
-std::list<Entity*> Scene::FindEntityWithComponent(ComponentType componentType) const
+const DenseRegistry<Entity*>& Scene::FindEntityWithComponent(ComponentType componentType) const
 {
-	std::list<Entity*> foundEntities;
-	for (Entity* entity : entities)
-	{
-		if (entity->GetComponent(componentType))
-		{
-			foundEntities.push_back(entity);
-		}
-	}
-	// Maybe the entity is yet to be added
-	for (Entity* entity : entitiesToBeAdded)
+	return componentViews[componentType];
+}
+
+Entity* Scene::FindUniqueEntityWithComponent(ComponentType componentType) const
+{
+	const DenseRegistry<Entity*>& view = componentViews[componentType];
+	if (view.Size() > 1)
 	{
-		if (entity->GetComponent(componentType))
-		{
-			foundEntities.push_back(entity);
-		}
+		// No entity of the view is the "first" one, so don't pick one at random
+		Logger::Get().Log(std::to_string(view.Size()) + " entities have a " + ComponentTypeToStr(componentType) + " component, expected one.", ERROR_LOG);
+		return nullptr;
 	}
-	return foundEntities;
+	return view.IsEmpty() ? nullptr : view[0];
 }
 
 void Scene::RemoveEntity(Entity* entity)
 {
+	// Already removed (e.g. destroyed by 2 systems in the same frame). Freeing it again would corrupt its pool.
+	if (entity->sceneHandle.IsNull())
+	{
+		Logger::Get().Log("Entity " + entity->GetName() + " is not in the scene, it can't be removed.", WARNING_LOG);
+		return;
+	}
 	entity->sourcePool->MarkObjectAsFree(entity);
 }
 
+void Scene::RemoveEntity(EntityHandle handle)
+{
+	Entity* entity = GetEntity(handle);
+	if (entity != nullptr)
+		RemoveEntity(entity);
+}
+
 void Scene::RemoveEntity(std::string& entityGUID)
 {
 	RemoveEntity(GetHashCode(entityGUID.c_str()));
 }
 
 void Scene::RemoveEntity(STRCODE entityId)
+{
+	Entity* entity = FindEntity(entityId);
+	if (entity != nullptr)
+		RemoveEntity(entity);
+}
+
+void Scene::Defer(std::function<void()> command)
+{
+	if (deferredCommandOrder == NOT_IN_PARALLEL_UPDATE)
+	{
+		command();
+		return;
+	}
+
+	DeferredCommand deferred;
+	deferred.order = deferredCommandOrder;
+	deferred.func = std::move(command);
+	deferredCommands[JobSystem::GetThreadIndex()].push_back(std::move(deferred));
+}
+
+void Scene::DeferRemoveEntity(Entity* entity)
+{
+	// By handle, so that removing it twice in a frame, or after its pool reused it, does nothing
+	EntityHandle handle = entity->GetHandle();
+	Defer([this, handle]() { RemoveEntity(handle); });
+}
+
+void Scene::DeferCreateEntity(const std::vector<ComponentType>& components, std::function<void(Entity*)> setup)
+{
+	Defer([this, components, setup]() {
+		std::vector<ComponentType> comps = components;
+		Entity* entity = CreateEntity(comps);
+		if (setup != nullptr)
+			setup(entity);
+	});
+}
+
+STRCODE Scene::HashState(STRCODE hash) const
 {
 	for (Entity* entity : entities)
 	{
-		if (entity->GetUid() == entityId)
-		{
-			RemoveEntity(entity);
-		}
+		const Transform& transform = entity->GetTransform();
+		hash = HashBytes(&transform.position.x, 3 * sizeof(float), hash);
+		hash = HashBytes(&transform.rotation.x, 3 * sizeof(float), hash);
+		hash = HashBytes(&transform.scale.x, 3 * sizeof(float), hash);
 	}
+	return hash;
 }
 
 void Scene::UntrackEntity(Entity* entity)
 {
-	entitiesToUntrack.push_back(entity);
+	if (entity->sceneHandle.IsNull())
+		return;
+
+	// Stays in the registry till PostUpdate, but its handle is stale & lookups can't find it from now on
+	entitiesToUntrack.push_back(entity->sceneHandle);
+	entity->scene = nullptr;
+	entity->sceneHandle = EntityHandle();
+	entitiesByUid.erase(entity->GetUid());
+	RemoveFromNameIndex(entity);
+	for (int type = 0; type < COMPONENT_TYPE_COUNT; type++)
+	{
+		if (entity->componentMask & ComponentTypeBit(static_cast<ComponentType>(type)))
+			RemoveFromComponentView(entity, static_cast<ComponentType>(type));
+	}
+}
+
+void Scene::AddToComponentView(Entity* entity, ComponentType componentType)
+{
+	entity->componentViewHandles[componentType] = componentViews[componentType].Add(entity);
+
+	// Types updated by a system (particles) are spread across the cores by that system
+	Component* component = entity->componentSlots[componentType];
+	if (component != nullptr && component->IsParallelSafe() && !component->IsUpdatedBySystem())
+		parallelComponentTypes |= ComponentTypeBit(componentType);
+}
+
+void Scene::RemoveFromComponentView(Entity* entity, ComponentType componentType)
+{
+	componentViews[componentType].Remove(entity->componentViewHandles[componentType]);
+	entity->componentViewHandles[componentType] = INVALID_REGISTRY_HANDLE;
+}
+
+void Scene::RenameEntity(Entity* entity, const std::string& newName)
+{
+	if (entity->sceneHandle.IsNull())
+	{
+		entity->name = newName;
+		return;
+	}
+
+	RemoveFromNameIndex(entity);
+	entity->name = newName;
+	entitiesByName[entity->name].push_back(entity);
 }
@@ -6,12 +6,21 @@
 #ifndef _SCENE_H_
 #define _SCENE_H_
 
-class Entity;
+#include "Engine/Core/DenseRegistry.h"
+#include "Engine/Components/Entity.h"
 
 /**
  * @class Scene
  *
  * Scene class contains and manages all the entities within it.
+ *
+ * Entities are kept packed in a DenseRegistry & get a generational handle as soon as they are created.
+ * Removal is deferred to PostUpdate (swap-and-pop), so the entities never move while they are being updated.
+ * Entities created in a frame are updated from the next frame.
+ *
+ * Components which opt in as parallel-safe (Component::isParallelSafe) are updated on all cores at once, one
+ * component type at a time. Structural changes they make go through Defer & are applied on the main thread.
+ * They are updated before every serial component of the frame (see Update).
  */
 class Scene final
 {
@@ -20,11 +29,36 @@ private:
 	std::string guid = "";
 	STRCODE uid = 0;
 
-	std::list<Entity*> entitiesToBeAdded;
-	std::list<Entity*> entities;
+	DenseRegistry<Entity*> entities;
 	// Any entity which is part of this becomes dangling
 	// Useful in object pooling
-	std::list<Entity*> entitiesToUntrack;
+	std::vector<EntityHandle> entitiesToUntrack;
+
+	// Lookup indexes, kept in sync on track, untrack & rename
+	std::unordered_map<STRCODE, Entity*> entitiesByUid;
+	std::unordered_map<std::string, std::vector<Entity*>> entitiesByName;
+	// Entities having each component type
+	DenseRegistry<Entity*> componentViews[COMPONENT_TYPE_COUNT];
+	// Component types updated in parallel by Update
+	ComponentMask parallelComponentTypes = 0;
+
+	// Command recorded by a component updated in parallel. Commands are applied in entity order, so the
+	// result doesn't depend on which thread got which entity.
+	struct DeferredCommand
+	{
+		unsigned long long order = 0;
+		std::function<void()> func;
+	};
+	// One buffer per job system thread (see JobSystem::GetThreadIndex), so recording doesn't need a lock
+	std::vector<std::vector<DeferredCommand>> deferredCommands;
+
+	/**
+	 * @brief Apply the commands recorded during the parallel updates, on the calling thread.
+	 */
+	void PlayDeferredCommands();
+
+	void TrackEntity(Entity* entity);
+	void RemoveFromNameIndex(Entity* entity);
 
 	// Function to load the initial data of the scene
 	std::function<void(Scene*)> LoadSceneFunc = nullptr;
@@ -57,13 +91,19 @@ protected:
 	void Initialize();
 
 	/**
-	 * @brief Load the to-be-added entities.
+	 * @brief Call PreUpdate on all the active entities.
 	 */
 	void PreUpdate();
 	/**
 	 * @brief Update all the active entities.
 	 */
 	void Update(float);
+	/**
+	 * @brief Update the parallel-safe components of a type, instead of their entities.
+	 * Entities are spread across the job system, so the components must not touch anything but themselves.
+	 * Commands they Defer are kept till PlayDeferredCommands.
+	 */
+	void UpdateComponentsInParallel(ComponentType componentType, float deltaTime);
 	/**
 	 * @brief Remove the to-be-destroyed entities.
 	 */
@@ -88,6 +128,13 @@ public:
 	 * @return Pointer to the created entity.
 	 */
 	Entity* CreateEntity(std::vector<ComponentType>& components);
+	/**
+	 * @brief Create several entities with the same components at once.
+	 *
+	 * @param count Number of entities
+	 * @param result The created entities are appended to it
+	 */
+	void CreateEntities(std::vector<ComponentType>& components, size_t count, std::vector<Entity*>& result);
 	/**
 	 * @brief Add a dangling entity to the scene.
 	 *
@@ -95,6 +142,14 @@ public:
 	 */
 	void AddDanglingEntity(Entity* entity);
 
+	/**
+	 * @brief Get the entity of a handle.
+	 *
+	 * @param handle Handle of the entity.
+	 * @return Pointer to the entity, or nullptr if it was removed since the handle was taken.
+	 */
+	Entity* GetEntity(EntityHandle handle) const;
+
 	/**
 	 * @brief Find an entity in the scene.
 	 *
@@ -114,29 +169,65 @@ public:
 	 * Entities in a scene can have same name.
 	 *
 	 * @param entityName Name of the entity.
-	 * @return List of pointers to the matched entities.
+	 * @return Pointers to the matched entities. Valid till an entity is added, removed or renamed.
 	 */
-	std::list<Entity*> FindEntityByName(const std::string& entityName) const;
+	const std::vector<Entity*>& FindEntityByName(const std::string& entityName) const;
 	/**
 	 * @brief Lookup entities with a certain component.
+	 * The scene keeps a view of every component type up to date, so this doesn't search.
+	 *
+	 * The entities are in no particular order. Removals swap the last entity into the gap, so don't rely on
+	 * which one comes first; use FindUniqueEntityWithComponent for an entity there must be only one of.
+	 *
+	 * @param componentType Type of the component
+	 * @return Pointers to the found entities. Valid till an entity is added or removed, or gains or loses a component.
+	 */
+	const DenseRegistry<Entity*>& FindEntityWithComponent(ComponentType componentType) const;
+	/**
+	 * @brief Lookup the only entity with a certain component (e.g. the UI manager).
 	 *
 	 * @param componentType Type of the component
-	 * @return List of pointers to the found entities.
+	 * @return Pointer to the entity, or nullptr if no entity or several entities have the component.
 	 */
-	std::list<Entity*> FindEntityWithComponent(ComponentType componentType) const;
+	Entity* FindUniqueEntityWithComponent(ComponentType componentType) const;
 
 
 	/**
 	 * @brief Remove an entity from the active scene.
 	 * It does not actually free up the memory of the entity.
 	 * It simply returns the entity back to the object pool and marks it as free.
+	 * Removing an entity again does nothing.
 	 * 
 	 * @param entity Pointer to the entity
 	 */
 	void RemoveEntity(Entity* entity);
+	/**
+	 * @brief Remove the entity of a handle. Does nothing if the handle is stale.
+	 */
+	void RemoveEntity(EntityHandle handle);
 	void RemoveEntity(STRCODE entityId);
 	void RemoveEntity(std::string& entityGUID);
 
+	/**
+	 * @brief Run a structural change (creating or removing entities, touching anything shared) at a safe point.
+	 * Called while components are updated in parallel, it is recorded & run on the main thread once they are
+	 * all done. Called from anywhere else, it runs right away.
+	 *
+	 * @param command Function making the change.
+	 */
+	void Defer(std::function<void()> command);
+	/**
+	 * @brief Remove an entity through Defer. Safe to call from a parallel-safe component.
+	 */
+	void DeferRemoveEntity(Entity* entity);
+	/**
+	 * @brief Create an entity through Defer. Safe to call from a parallel-safe component.
+	 *
+	 * @param components Components of the entity.
+	 * @param setup Called with the created entity, to set it up.
+	 */
+	void DeferCreateEntity(const std::vector<ComponentType>& components, std::function<void(Entity*)> setup);
+
 	/**
 	 * @brief Remove an entity from the Scene without actually deleting it.
 	 *
@@ -144,6 +235,24 @@ public:
 	 */
 	void UntrackEntity(Entity* entity);
 
+	/**
+	 * @brief Rename an entity of the scene, keeping the name lookup up to date. Used by Entity::SetName.
+	 */
+	void RenameEntity(Entity* entity, const std::string& newName);
+
+	/**
+	 * @brief Keep the component views up to date when an entity of the scene gains or loses a component type.
+	 */
+	void AddToComponentView(Entity* entity, ComponentType componentType);
+	void RemoveFromComponentView(Entity* entity, ComponentType componentType);
+
+	/**
+	 * @brief Hash the transforms of all entities, in the order they are updated.
+	 *
+	 * @param hash Hash to continue from.
+	 */
+	STRCODE HashState(STRCODE hash) const;
+
 	// ----------------------- Getters & Setters -----------------------------------
 
 	const std::string& GetGUID() const { return guid; }
@@ -153,6 +262,7 @@ public:
 	void SetLoadSceneFunc(std::function<void(Scene*)> foo) { LoadSceneFunc = foo; }
 
 	friend class SceneManager;
+	friend class TestScene;
 };
 
 #endif // !_SCENE_H_
@@ -11,6 +11,7 @@
 
 void SceneManager::Load()
 {
+	PrewarmPools();
 	activeScene->Load();
 }
 
@@ -36,6 +37,11 @@ void SceneManager::Update(float deltaTime)
 	activeScene->Update(deltaTime);
 }
 
+void SceneManager::UpdateParticles(float deltaTime)
+{
+	activeScene->UpdateComponentsInParallel(ParticlesC, deltaTime);
+}
+
 void SceneManager::PostUpdate()
 {
 	activeScene->PostUpdate();
@@ -89,7 +95,7 @@ void SceneManager::SetActiveScene(Scene* scene)
 	newActiveScene = scene;
 }
 
-Entity* SceneManager::GetNewEntity(std::vector<ComponentType>& components)
+EntityPool* SceneManager::GetEntityPool(std::vector<ComponentType>& components)
 {
 	// Generally, there's just 1 canvas entity in a scene. So its pool size can be 1.
 	bool hasCanvas = false;
@@ -113,12 +119,125 @@ Entity* SceneManager::GetNewEntity(std::vector<ComponentType>& components)
 			relevantPool = new EntityPool(components);
 		// Track it
 		entityPools[compHash] = relevantPool;
+
+		if (poolsPrewarmed)
+			Logger::Get().Log("Entity pool " + relevantPool->GetName() + " created during gameplay. Add it to the pool config.", WARNING_LOG);
 	}
 	else
 	{
 		relevantPool = entityPools[compHash];
 	}
-	return static_cast<Entity*>(relevantPool->GetFreeObject());
+	return relevantPool;
+}
+
+Entity* SceneManager::GetNewEntity(std::vector<ComponentType>& components)
+{
+	return static_cast<Entity*>(GetEntityPool(components)->GetFreeObject());
+}
+
+void SceneManager::GetNewEntities(std::vector<ComponentType>& components, size_t count, std::vector<Entity*>& result)
+{
+	pooledObjects.clear();
+	GetEntityPool(components)->GetFreeObjects(count, pooledObjects);
+	for (Object* object : pooledObjects)
+	{
+		result.push_back(static_cast<Entity*>(object));
+	}
+}
+
+void SceneManager::PrewarmPools()
+{
+	for (PoolConfigEntry& entry : poolConfig)
+	{
+		GetEntityPool(entry.components)->Prewarm(entry.poolSize);
+	}
+	poolsPrewarmed = true;
+}
+
+bool SceneManager::LoadPoolConfig(const std::string& filename)
+{
+	std::ifstream file(filename);
+	if (!file.is_open())
+	{
+		Logger::Get().Log("Could not open pool config " + filename + ". Entity pools will start at their default size.", WARNING_LOG);
+		return false;
+	}
+
+	poolConfig.clear();
+	std::string line;
+	while (std::getline(file, line))
+	{
+		// Skip comments & empty lines
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::istringstream lineStream(line);
+		PoolConfigEntry entry;
+		if (!(lineStream >> entry.poolSize))
+		{
+			Logger::Get().Log("Invalid line in pool config: " + line, ERROR_LOG);
+			continue;
+		}
+
+		bool isValid = true;
+		std::string componentName;
+		while (lineStream >> componentName)
+		{
+			ComponentType componentType = StrToComponentType(componentName);
+			if (componentType == UNDEFINEDC)
+				isValid = false;
+			entry.components.push_back(componentType);
+		}
+		if (!isValid || entry.components.empty())
+		{
+			Logger::Get().Log("Invalid line in pool config: " + line, ERROR_LOG);
+			continue;
+		}
+		poolConfig.push_back(entry);
+	}
+
+	Logger::Get().Log("Loaded pool config " + filename + " with " + std::to_string(poolConfig.size()) + " entity pools.");
+	return true;
+}
+
+bool SceneManager::SavePoolConfig(const std::string& filename) const
+{
+	// Same archetypes in the same order every time, so that configs can be diffed
+	std::vector<std::pair<std::string, size_t>> lines;
+	for (const auto& itr : entityPools)
+	{
+		const EntityPool* pool = itr.second;
+		if (pool->GetHighWaterMark() > 0)
+			lines.push_back(std::make_pair(pool->GetName(), pool->GetHighWaterMark()));
+	}
+	std::sort(lines.begin(), lines.end());
+
+	std::ofstream file(filename);
+	if (!file.is_open())
+	{
+		Logger::Get().Log("Could not write pool config " + filename, ERROR_LOG);
+		return false;
+	}
+	file << "# Entity pool sizes. One archetype per line: <pool size> <component types>\n";
+	file << "# Written by SceneManager::SavePoolConfig from the most entities in use at once.\n";
+	for (const auto& line : lines)
+	{
+		file << line.second << " " << line.first << "\n";
+	}
+
+	Logger::Get().Log("Saved suggested pool config " + filename);
+	return true;
+}
+
+void SceneManager::LogPoolUsage() const
+{
+	for (const auto& itr : entityPools)
+	{
+		const EntityPool* pool = itr.second;
+		std::string logMsg = "Entity pool " + pool->GetName() + ": " + std::to_string(pool->GetObjectCount()) + " entities, " +
+			std::to_string(pool->GetHighWaterMark()) + " in use at most, grew " + std::to_string(pool->GetGrowthCount()) + " times.";
+		Logger::Get().Log(logMsg, pool->GetGrowthCount() > 0 ? WARNING_LOG : DEBUG_LOG);
+	}
 }
 
 void SceneManager::StorePersistentData(STRCODE hashkey, std::string& dataStr)
@@ -36,6 +36,8 @@ private:
 	// There are different entity pools because different entities have different types of components
 	// attached to them. Having different pools ensures both less memory fragmentation as well as cache coherence.
 	std::unordered_map<STRCODE, EntityPool*> entityPools;
+	// Objects handed out by a pool in a bulk call
+	std::vector<Object*> pooledObjects;
 
 	// Keep track of all the created scenes as only Scene Manager can destroy & delete scenes
 	// NOTE: Developers are allowed to create new scenes using SceneManager & change the active scene, but they can't delete scenes.
@@ -44,6 +46,26 @@ private:
 	// Persistent data between scenes
 	std::unordered_map<STRCODE, std::string> persistentData;
 
+	// Size of the entity pool of an archetype, as read from the pool config
+	struct PoolConfigEntry
+	{
+		std::vector<ComponentType> components;
+		size_t poolSize = 0;
+	};
+	std::vector<PoolConfigEntry> poolConfig;
+	// Pools created after this are logged, they should be in the pool config
+	bool poolsPrewarmed = false;
+
+	/**
+	 * @brief Create the entity pools of the pool config at their configured sizes.
+	 */
+	void PrewarmPools();
+
+	/**
+	 * @brief Get the entity pool of the components, creating it if there is none.
+	 */
+	EntityPool* GetEntityPool(std::vector<ComponentType>& components);
+
 protected:
 	/**
 	 * @brief Load the active scene data.
@@ -66,6 +88,11 @@ protected:
 	 */
 	void Update(float);
 
+	/**
+	 * @brief Update the particles of the active scene, in parallel.
+	 */
+	void UpdateParticles(float);
+
 	/**
 	 * @brief Call PostUpdate on the active scene.
 	 * If active scene got changed, the current scene gets destroyed here.
@@ -115,6 +142,35 @@ public:
 	 * @return Pointer to the entity.
 	 */
 	Entity* GetNewEntity(std::vector<ComponentType>& components);
+	/**
+	 * @brief Get several entities of the same components at once.
+	 *
+	 * @param count Number of entities
+	 * @param result The entities are appended to it
+	 */
+	void GetNewEntities(std::vector<ComponentType>& components, size_t count, std::vector<Entity*>& result);
+
+	/**
+	 * @brief Read the entity pool sizes. The pools get created at these sizes when the scene is loaded,
+	 * so that they don't have to grow during gameplay.
+	 * Each line is a pool size followed by the component types of the archetype, in the order the game asks for them.
+	 *
+	 * @param filename Path of the pool config.
+	 * @return False if the file couldn't be read.
+	 */
+	bool LoadPoolConfig(const std::string& filename);
+	/**
+	 * @brief Write a pool config with the most entities each pool had in use at once during this run.
+	 * Play a session & use it as the pool config to remove pool growth during gameplay.
+	 *
+	 * @param filename Path of the suggested pool config.
+	 * @return False if the file couldn't be written.
+	 */
+	bool SavePoolConfig(const std::string& filename) const;
+	/**
+	 * @brief Log the size, high-water mark & number of growths of each entity pool.
+	 */
+	void LogPoolUsage() const;
 
 	/**
 	 * @brief Store data that remains persistent as long as the application runs.
@@ -0,0 +1,126 @@
+// @file: TestDebrisSystem.cpp
+//
+// @brief: Cpp file for TestDebrisSystem class containing unit tests for DebrisSystem class.
+
+#include "stdafx.h"
+#include "TestDebrisSystem.h"
+#include "Engine/Systems/DebrisSystem.h"
+#include "Engine/Core/Logger.h"
+
+// Update only needs a valid mesh ID, the mesh itself is only used for rendering
+static const int TEST_MESH = 0;
+
+void TestDebrisSystem::RunTests()
+{
+	TestRingWrapAround();
+	TestExpiry();
+	TestFloorClamp();
+
+	// Leave nothing behind for the game. The engine initializes the system again anyway.
+	DebrisSystem::Get().SetFloor(false);
+	DebrisSystem::Get().Initialize();
+	Logger::Get().Log("[UNITTEST] DebrisSystem - All tests passed!");
+}
+
+void TestDebrisSystem::TestRingWrapAround()
+{
+	DebrisSystem& debris = DebrisSystem::Get();
+	debris.Initialize();
+
+	DebrisBurst first;
+	first.color = Vector3(1.0f, 0.0f, 0.0f);
+	first.lifeTime = 10.0f;
+	debris.SpawnBurst(std::vector<int>(DebrisSystem::MAX_FRAGMENTS, TEST_MESH), first);
+	assert(debris.GetFragmentCount() == DebrisSystem::MAX_FRAGMENTS);
+	assert(debris.nextFragment == 0);
+
+	// A full ring replaces its oldest fragments & keeps the count
+	DebrisBurst second = first;
+	second.color = Vector3(0.0f, 1.0f, 0.0f);
+	debris.SpawnBurst(std::vector<int>(10, TEST_MESH), second);
+	assert(debris.GetFragmentCount() == DebrisSystem::MAX_FRAGMENTS);
+	assert(debris.nextFragment == 10);
+	for (size_t idx = 0; idx < 10; idx++)
+		assert(debris.colors[idx].y == 1.0f);
+	assert(debris.colors[10].x == 1.0f);
+	assert(debris.colors[DebrisSystem::MAX_FRAGMENTS - 1].x == 1.0f);
+
+	// Invalid meshes don't take a slot
+	debris.SpawnBurst(std::vector<int>{ -1 }, second);
+	assert(debris.nextFragment == 10);
+
+	debris.Clear();
+	assert(debris.GetFragmentCount() == 0);
+}
+
+void TestDebrisSystem::TestExpiry()
+{
+	DebrisSystem& debris = DebrisSystem::Get();
+	debris.Initialize();
+	debris.SetFloor(false);
+
+	DebrisBurst burst;
+	burst.lifeTime = 1.0f;
+	debris.SpawnBurst(std::vector<int>(3, TEST_MESH), burst);
+	DebrisBurst longBurst;
+	longBurst.lifeTime = 5.0f;
+	debris.SpawnBurst(std::vector<int>{ TEST_MESH }, longBurst);
+	assert(debris.GetFragmentCount() == 4);
+
+	// Life is in seconds, update time in ms
+	debris.Update(500.0f);
+	assert(debris.GetFragmentCount() == 4);
+	debris.Update(600.0f);
+	assert(debris.GetFragmentCount() == 1);
+	assert(debris.lifeLeft[3] > 0.0f);
+
+	// Falling below the kill height ends it early
+	debris.positionY[3] = debris.killHeight - 1.0f;
+	debris.velocityY[3] = 0.0f;
+	debris.Update(1.0f);
+	assert(debris.GetFragmentCount() == 0);
+
+	// Dead slots are taken again & counted once
+	debris.SpawnBurst(std::vector<int>{ TEST_MESH }, burst);
+	assert(debris.GetFragmentCount() == 1);
+	debris.Clear();
+}
+
+void TestDebrisSystem::TestFloorClamp()
+{
+	DebrisSystem& debris = DebrisSystem::Get();
+	debris.Initialize();
+	const float floorHeight = -8.0f;
+	debris.SetFloor(true, floorHeight);
+
+	DebrisBurst burst;
+	burst.position = Vector3(0.0f, floorHeight + 1.0f, 0.0f);
+	burst.verticalJitter = 0.0f;
+	burst.lifeTime = 10.0f;
+	debris.SpawnBurst(std::vector<int>{ TEST_MESH }, burst);
+
+	// Crosses the floor in one update: put back on it, bounced up, slowed down
+	debris.velocityX[0] = 10.0f;
+	debris.velocityY[0] = -50.0f;
+	debris.velocityZ[0] = 10.0f;
+	debris.Update(100.0f);
+	assert(debris.positionY[0] == floorHeight);
+	assert(debris.velocityY[0] > 0.0f && debris.velocityY[0] < 50.0f);
+	assert(debris.velocityX[0] < 10.0f && debris.velocityZ[0] < 10.0f);
+
+	// Never goes through, however long it keeps falling
+	for (int frame = 0; frame < 100; frame++)
+	{
+		debris.velocityY[0] = std::min(debris.velocityY[0], -20.0f);
+		debris.Update(16.0f);
+		assert(debris.positionY[0] >= floorHeight);
+	}
+	assert(debris.GetFragmentCount() == 1);
+
+	// Without the floor, it falls through
+	debris.SetFloor(false);
+	debris.velocityY[0] = -50.0f;
+	debris.Update(100.0f);
+	assert(debris.positionY[0] < floorHeight);
+	debris.Clear();
+}
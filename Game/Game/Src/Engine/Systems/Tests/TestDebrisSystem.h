@@ -0,0 +1,19 @@
+// @file: TestDebrisSystem.h
+//
+// @brief: Header file for TestDebrisSystem class containing unit tests for DebrisSystem class.
+
+#pragma once
+#ifndef _TEST_DEBRIS_SYSTEM_H_
+#define _TEST_DEBRIS_SYSTEM_H_
+
+class TestDebrisSystem
+{
+	static void TestRingWrapAround();
+	static void TestExpiry();
+	static void TestFloorClamp();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_DEBRIS_SYSTEM_H_
@@ -0,0 +1,392 @@
+// @file: TestScene.cpp
+//
+// @brief: Cpp file for TestScene class containing unit tests for Scene class.
+
+#include "stdafx.h"
+#include "TestScene.h"
+#include "Engine/Systems/Scene.h"
+#include "Engine/Components/Entity.h"
+#include "Engine/Components/Component.h"
+#include "Engine/Pools/EntityPool.h"
+#include "Engine/Pools/ComponentAllocator.h"
+#include "Engine/Core/Logger.h"
+#include "Engine/Core/JobSystem.h"
+
+// Test components are freed like any component made by CreateComponent, so they take a slot of their type
+template <typename T, typename... Args>
+static T* NewTestComponent(ComponentType type, Args&&... args)
+{
+	assert(sizeof(T) <= ComponentTypeSize(type));
+	return new (ComponentAllocator::Get().Allocate(type)) T(std::forward<Args>(args)...);
+}
+
+// Component logging its updates, parallel-safe or serial
+class UpdateProbe : public Component
+{
+	std::vector<int>& updates;
+	int id;
+
+public:
+	UpdateProbe(ComponentType probeType, bool parallelSafe, std::vector<int>& _updates, int _id) : updates(_updates), id(_id)
+	{
+		type = probeType;
+		isParallelSafe = parallelSafe;
+	}
+
+	void Initialize() override {}
+	void Destroy() override {}
+	void Update(float) override { updates.push_back(id); }
+};
+
+// Parallel-safe component which waits till another thread has updated one too, then defers its id
+struct ThreadProbeLog
+{
+	Scene* scene = nullptr;
+	std::vector<std::atomic<bool>> threadsUsed;
+	std::atomic<size_t> threadCount{ 0 };
+	std::vector<int> deferredIds;
+};
+
+class ThreadProbe : public Component
+{
+	ThreadProbeLog& log;
+	int id;
+
+public:
+	ThreadProbe(ThreadProbeLog& _log, int _id) : log(_log), id(_id)
+	{
+		type = DoorOpenerC;
+		isParallelSafe = true;
+	}
+
+	int GetId() const { return id; }
+
+	void Initialize() override {}
+	void Destroy() override {}
+	void Update(float) override
+	{
+		if (!log.threadsUsed[JobSystem::GetThreadIndex()].exchange(true))
+			log.threadCount.fetch_add(1);
+		// A deadline, so that a serial run fails the test instead of hanging
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (log.threadCount.load() < 2 && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::yield();
+		}
+
+		std::vector<int>& ids = log.deferredIds;
+		int probeId = id;
+		log.scene->Defer([&ids, probeId]() { ids.push_back(probeId); });
+	}
+};
+
+void TestScene::RunTests()
+{
+	// Parallel-safe components must really get spread across threads
+	JobSystem::Get().Initialize(3);
+
+	TestUidIndex();
+	TestNameIndex();
+	TestRenameOwningScene();
+	TestStaleHandle();
+	TestComponentViews();
+	TestUniqueEntityWithComponent();
+	TestParallelUpdate();
+	TestParallelUpdateThreads();
+
+	JobSystem::Get().Destroy();
+	Logger::Get().Log("[UNITTEST] Scene - All tests passed!");
+}
+
+void TestScene::TestUidIndex()
+{
+	// Entities having only a transform, so that the pool doesn't register anything with the engine systems
+	std::vector<ComponentType> types;
+	EntityPool pool(types, 4);
+	Scene* scene = new Scene();
+
+	Entity* first = static_cast<Entity*>(pool.GetFreeObject());
+	Entity* second = static_cast<Entity*>(pool.GetFreeObject());
+	assert(scene->FindEntity(first->GetUid()) == nullptr);
+	scene->AddDanglingEntity(first);
+	scene->AddDanglingEntity(second);
+
+	// Lookup by uid & guid
+	assert(scene->FindEntity(first->GetUid()) == first);
+	assert(scene->FindEntity(second->GetUid()) == second);
+	assert(scene->FindEntity(first->GetGUID()) == first);
+
+	// Removed entities can't be found anymore, even before PostUpdate
+	scene->RemoveEntity(first);
+	assert(scene->FindEntity(first->GetUid()) == nullptr);
+	assert(scene->FindEntity(second->GetUid()) == second);
+	scene->PostUpdate();
+	assert(scene->FindEntity(first->GetUid()) == nullptr);
+
+	scene->RemoveEntity(second->GetUid());
+	assert(scene->FindEntity(second->GetUid()) == nullptr);
+	scene->PostUpdate();
+	assert(pool.GetFreeObjectCount() == pool.GetObjectCount());
+	delete scene;
+}
+
+void TestScene::TestNameIndex()
+{
+	std::vector<ComponentType> types;
+	EntityPool pool(types, 4);
+	Scene* scene = new Scene();
+
+	// Named before it is added
+	Entity* first = static_cast<Entity*>(pool.GetFreeObject());
+	first->SetName("Crate");
+	scene->AddDanglingEntity(first);
+	Entity* second = static_cast<Entity*>(pool.GetFreeObject());
+	scene->AddDanglingEntity(second);
+	// Named after it is added
+	second->SetName("Crate");
+
+	const std::vector<Entity*>& crates = scene->FindEntityByName("Crate");
+	assert(crates.size() == 2);
+	assert(std::find(crates.begin(), crates.end(), first) != crates.end());
+	assert(std::find(crates.begin(), crates.end(), second) != crates.end());
+	assert(scene->FindEntityByName("Ball").empty());
+
+	// Rename moves it to the new name only
+	second->SetName("Ball");
+	assert(second->GetName() == "Ball");
+	assert(scene->FindEntityByName("Crate").size() == 1 && scene->FindEntityByName("Crate")[0] == first);
+	assert(scene->FindEntityByName("Ball").size() == 1 && scene->FindEntityByName("Ball")[0] == second);
+
+	// Removal
+	scene->RemoveEntity(first);
+	assert(scene->FindEntityByName("Crate").empty());
+	assert(scene->FindEntityByName("Ball").size() == 1);
+
+	// Renaming a removed entity doesn't put it back in the index
+	first->SetName("Ball");
+	assert(scene->FindEntityByName("Ball").size() == 1 && scene->FindEntityByName("Ball")[0] == second);
+
+	scene->RemoveEntity(second);
+	assert(scene->FindEntityByName("Ball").empty());
+	scene->PostUpdate();
+	delete scene;
+}
+
+void TestScene::TestRenameOwningScene()
+{
+	std::vector<ComponentType> types;
+	EntityPool pool(types, 2);
+	Scene* owner = new Scene();
+	Scene* other = new Scene();
+
+	Entity* entity = static_cast<Entity*>(pool.GetFreeObject());
+	owner->AddDanglingEntity(entity);
+
+	// Renames go to the scene of the entity, whichever scene is active
+	entity->SetName("Door");
+	assert(owner->FindEntityByName("Door").size() == 1);
+	assert(other->FindEntityByName("Door").empty());
+
+	// Its pool removes it from its own scene too
+	owner->RemoveEntity(entity);
+	assert(owner->FindEntity(entity->GetUid()) == nullptr);
+	assert(owner->FindEntityByName("Door").empty());
+	owner->PostUpdate();
+	delete owner;
+	delete other;
+}
+
+void TestScene::TestStaleHandle()
+{
+	// A single entity, so the pool has to hand the same one out again
+	std::vector<ComponentType> types;
+	EntityPool pool(types, 1);
+	Scene* scene = new Scene();
+
+	Entity* entity = static_cast<Entity*>(pool.GetFreeObject());
+	scene->AddDanglingEntity(entity);
+	EntityHandle oldHandle = entity->GetHandle();
+	assert(!oldHandle.IsNull());
+	assert(scene->GetEntity(oldHandle) == entity);
+
+	// Stale right away, even though the entity stays in the registry till PostUpdate
+	scene->RemoveEntity(entity);
+	assert(entity->GetHandle().IsNull());
+	assert(scene->GetEntity(oldHandle) == nullptr);
+	scene->PostUpdate();
+	assert(scene->GetEntity(oldHandle) == nullptr);
+
+	// The pool hands the same entity out & the registry reuses its slot with a new generation
+	Entity* reused = static_cast<Entity*>(pool.GetFreeObject());
+	assert(reused == entity);
+	scene->AddDanglingEntity(reused);
+	EntityHandle newHandle = reused->GetHandle();
+	assert(newHandle != oldHandle);
+	assert(scene->GetEntity(oldHandle) == nullptr);
+	assert(scene->GetEntity(newHandle) == reused);
+
+	// Removing through the stale handle must leave the new entity alone
+	scene->RemoveEntity(oldHandle);
+	assert(scene->GetEntity(newHandle) == reused);
+	assert(pool.GetFreeObjectCount() == 0);
+
+	scene->RemoveEntity(newHandle);
+	assert(scene->GetEntity(newHandle) == nullptr);
+	assert(pool.GetFreeObjectCount() == 1);
+	scene->PostUpdate();
+	delete scene;
+}
+
+static bool ViewHas(const DenseRegistry<Entity*>& view, Entity* entity)
+{
+	return std::find(view.begin(), view.end(), entity) != view.end();
+}
+
+void TestScene::TestComponentViews()
+{
+	// Game components which don't register with any engine system
+	std::vector<ComponentType> types{ SelfDestructC };
+	EntityPool pool(types, 4);
+	Scene* scene = new Scene();
+
+	Entity* first = static_cast<Entity*>(pool.GetFreeObject());
+	Entity* second = static_cast<Entity*>(pool.GetFreeObject());
+	scene->AddDanglingEntity(first);
+	scene->AddDanglingEntity(second);
+
+	const DenseRegistry<Entity*>& selfDestructs = scene->FindEntityWithComponent(SelfDestructC);
+	const DenseRegistry<Entity*>& balls = scene->FindEntityWithComponent(BallC);
+	assert(selfDestructs.Size() == 2 && ViewHas(selfDestructs, first) && ViewHas(selfDestructs, second));
+	assert(balls.IsEmpty());
+
+	// Adding a component type puts the entity in its view right away
+	Component* ball = CreateComponent(BallC);
+	ball->ChangeEntity(first);
+	first->TrackComponent(ball);
+	assert(first->HasComponent(BallC) && first->GetComponent(BallC) == ball);
+	assert(balls.Size() == 1 && balls[0] == first);
+
+	// Removing the only component of a type takes it out of the view, in PostUpdate
+	scene->PreUpdate();
+	assert(first->RemoveComponent(SelfDestructC));
+	assert(selfDestructs.Size() == 2);
+	scene->PostUpdate();
+	assert(!first->HasComponent(SelfDestructC));
+	assert(selfDestructs.Size() == 1 && selfDestructs[0] == second);
+	assert(balls.Size() == 1 && balls[0] == first);
+
+	// Removing the entity takes it out of all its views
+	scene->RemoveEntity(first);
+	assert(balls.IsEmpty());
+	assert(selfDestructs.Size() == 1 && selfDestructs[0] == second);
+	scene->RemoveEntity(second);
+	assert(selfDestructs.IsEmpty());
+	scene->PostUpdate();
+	delete scene;
+}
+
+void TestScene::TestUniqueEntityWithComponent()
+{
+	std::vector<ComponentType> types{ SelfDestructC };
+	EntityPool pool(types, 2);
+	Scene* scene = new Scene();
+	assert(scene->FindUniqueEntityWithComponent(SelfDestructC) == nullptr);
+
+	Entity* first = static_cast<Entity*>(pool.GetFreeObject());
+	scene->AddDanglingEntity(first);
+	assert(scene->FindUniqueEntityWithComponent(SelfDestructC) == first);
+
+	// With 2 of them, neither is the one
+	Entity* second = static_cast<Entity*>(pool.GetFreeObject());
+	scene->AddDanglingEntity(second);
+	assert(scene->FindUniqueEntityWithComponent(SelfDestructC) == nullptr);
+
+	scene->RemoveEntity(first);
+	assert(scene->FindUniqueEntityWithComponent(SelfDestructC) == second);
+	scene->RemoveEntity(second);
+	scene->PostUpdate();
+	delete scene;
+}
+
+void TestScene::TestParallelUpdate()
+{
+	std::vector<ComponentType> types;
+	EntityPool pool(types, 1);
+	Scene* scene = new Scene();
+	Entity* entity = static_cast<Entity*>(pool.GetFreeObject());
+	scene->AddDanglingEntity(entity);
+
+	// All of an entity's components of a type run on the same thread, so one log is enough.
+	// The serial one is tracked first, to make sure the order doesn't come from the component list.
+	std::vector<int> updates;
+	Component* probes[] = {
+		NewTestComponent<UpdateProbe>(BallSpawnerC, BallSpawnerC, false, updates, 0),
+		NewTestComponent<UpdateProbe>(DoorOpenerC, DoorOpenerC, true, updates, 1),
+		NewTestComponent<UpdateProbe>(DoorOpenerC, DoorOpenerC, true, updates, 2),
+	};
+	for (Component* probe : probes)
+	{
+		probe->ChangeEntity(entity);
+		entity->TrackComponent(probe);
+	}
+
+	// Not updated till PreUpdate, like serial components
+	scene->Update(0.0f);
+	assert(updates.empty());
+
+	// Every parallel-safe component of the type, before any serial one
+	scene->PreUpdate();
+	scene->Update(0.0f);
+	assert((updates == std::vector<int>{ 1, 2, 0 }));
+
+	// The second one is still updated once the first is gone
+	updates.clear();
+	assert(entity->RemoveComponent(probes[1]));
+	scene->PostUpdate();
+	scene->Update(0.0f);
+	assert((updates == std::vector<int>{ 2, 0 }));
+
+	scene->RemoveEntity(entity);
+	scene->PostUpdate();
+	delete scene;
+}
+
+void TestScene::TestParallelUpdateThreads()
+{
+	const size_t count = 32;
+	std::vector<ComponentType> types;
+	EntityPool pool(types, count);
+	Scene* scene = new Scene();
+
+	ThreadProbeLog log;
+	log.scene = scene;
+	log.threadsUsed = std::vector<std::atomic<bool>>(JobSystem::Get().GetWorkerCount() + 1);
+	std::vector<Entity*> entities;
+	for (size_t i = 0; i < count; i++)
+	{
+		Entity* entity = static_cast<Entity*>(pool.GetFreeObject());
+		entities.push_back(entity);
+		scene->AddDanglingEntity(entity);
+		Component* probe = NewTestComponent<ThreadProbe>(DoorOpenerC, log, static_cast<int>(i));
+		probe->ChangeEntity(entity);
+		entity->TrackComponent(probe);
+	}
+	scene->PreUpdate();
+	scene->Update(0.0f);
+
+	// Spread across threads, yet the deferred commands play in view order, as if it ran on one thread
+	assert(log.threadCount.load() >= 2);
+	const DenseRegistry<Entity*>& view = scene->FindEntityWithComponent(DoorOpenerC);
+	assert(log.deferredIds.size() == count);
+	for (size_t i = 0; i < count; i++)
+	{
+		assert(log.deferredIds[i] == static_cast<ThreadProbe*>(view[i]->GetComponent(DoorOpenerC))->GetId());
+	}
+
+	for (Entity* entity : entities)
+	{
+		scene->RemoveEntity(entity);
+	}
+	scene->PostUpdate();
+	delete scene;
+}
@@ -0,0 +1,24 @@
+// @file: TestScene.h
+//
+// @brief: Header file for TestScene class containing unit tests for Scene class.
+
+#pragma once
+#ifndef _TEST_SCENE_H_
+#define _TEST_SCENE_H_
+
+class TestScene
+{
+	static void TestUidIndex();
+	static void TestNameIndex();
+	static void TestRenameOwningScene();
+	static void TestStaleHandle();
+	static void TestComponentViews();
+	static void TestUniqueEntityWithComponent();
+	static void TestParallelUpdate();
+	static void TestParallelUpdateThreads();
+
+public:
+	static void RunTests();
+};
+
+#endif // !_TEST_SCENE_H_
@@ -14,6 +14,7 @@
 #include "Engine/Components/MeshRenderer.h"
 #include "Engine/Components/RigidBody.h"
 #include "Engine/Components/Particles.h"
+#include "Engine/Components/TriggerCollider.h"
 #include "Game/SelfDestruct.h"
 #include "Game/UIManager.h"
 
@@ -30,17 +31,23 @@ void BallSpawner::Initialize()
 	RenderSystem::Get().AttachCamera(GetEntity());
 
 	// Find the UIManager
-	std::list<Entity*> match = SceneManager::Get().GetActiveScene()->FindEntityWithComponent(UIManagerC);
-	if (match.size() == 0)
+	Entity* uiManagerEntity = SceneManager::Get().GetActiveScene()->FindUniqueEntityWithComponent(UIManagerC);
+	if (uiManagerEntity == nullptr)
 		Logger::Get().Log("Ball spawner could not find UI Manager", ERROR_LOG);
 	else
-		uiManager = static_cast<UIManager*>(match.front()->GetComponent(UIManagerC));
+		uiManager = static_cast<UIManager*>(uiManagerEntity->GetComponent(UIManagerC));
 
 	// Find the particles component
 	particles = static_cast<Particles*>(GetEntity()->GetComponent(ParticlesC));
 	particles->SetParticleType(SPEEDLINE);
 	particles->SetPositionOffset(Vector3{ 0.0f, 0.0f, 30.0f });
 	particles->SetParticleColors(Vector3(1.0f, 1.0f, 1.0f), Vector3(0.5f, 0.5f, 0.5f));
+
+	// Player sets off the triggers of the level (doors, planes etc.)
+	TriggerCollider* trigger = static_cast<TriggerCollider*>(GetEntity()->GetComponent(TriggerColliderC));
+	trigger->SetBox(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f));
+	trigger->SetColliderTag(PLAYER);
+	trigger->SetActivatesTriggers(true);
 }
 
 void BallSpawner::Update(float deltaTime)
@@ -8,15 +8,15 @@
 #include "Engine/Components/Entity.h"
 #include "Engine/Components/Transform.h"
 #include "Engine/Components/BoxCollider.h"
+#include "Engine/Components/TriggerCollider.h"
 #include "Engine/Components/RigidBody.h"
 #include "Engine/Components/MeshRenderer.h"
 #include "Engine/Components/Particles.h"
 #include "Engine/Math/Random.h"
 #include "Engine/Systems/SceneManager.h"
 #include "Engine/Systems/Scene.h"
-#include "Engine/Systems/RenderSystem.h"
 #include "Engine/Systems/CollisionSystem.h"
-#include "Game/SelfDestruct.h"
+#include "Engine/Systems/DebrisSystem.h"
 #include "Game/UIManager.h"
 #include "Game/DoorOpener.h"
 
@@ -31,25 +31,24 @@ void Breakable::LoadMeshes(std::string& meshObjFile, size_t meshPieces)
 	else
 		meshRenderer->SetMeshColor(Vector3(0.0f, 0.8f, 1.0f));
 
-	// Load broken mesh pieces
+	// Load broken mesh pieces. Debris system loads each file only once.
 	brokenPieces.clear();
 	for (size_t i = 0; i < meshPieces; i++)
 	{
-		Mesh mesh;
-		mesh.LoadFromObjectFile(meshObjFile + "_" + std::to_string(i + 1) + ".obj");
-		if (mesh.faces.size() > 0)
-			brokenPieces.push_back(mesh);
+		int meshId = DebrisSystem::Get().LoadMesh(meshObjFile + "_" + std::to_string(i + 1) + ".obj");
+		if (meshId >= 0)
+			brokenPieces.push_back(meshId);
 	}
 }
 
 void Breakable::Initialize()
 {
 	// Find the UIManager
-	std::list<Entity*> match = SceneManager::Get().GetActiveScene()->FindEntityWithComponent(UIManagerC);
-	if (match.size() == 0)
+	Entity* uiManagerEntity = SceneManager::Get().GetActiveScene()->FindUniqueEntityWithComponent(UIManagerC);
+	if (uiManagerEntity == nullptr)
 		Logger::Get().Log("Breakable could not find UI Manager", ERROR_LOG);
 	else
-		uiManager = static_cast<UIManager*>(match.front()->GetComponent(UIManagerC));
+		uiManager = static_cast<UIManager*>(uiManagerEntity->GetComponent(UIManagerC));
 
 	// Cache components
 	meshRenderer = static_cast<MeshRenderer*>(GetEntity()->GetComponent(MeshRendererC));
@@ -98,14 +97,24 @@ void Breakable::Initialize()
 	// ----------------------- RigidBody & Particles -----------------------
 	// Rigidbody settings
 	rigidBody->resCoeff = 0.0f;  // inelastic object
+	// Planes are moved only by their script (SHM movement). Balls can't push them around.
+	rigidBody->SetKinematic(breakableType == BreakableType::Plane);
 
 	if (breakableType == BreakableType::Plane)
 	{
 		// Plane shouldn't be affected by gravity
 		rigidBody->applyGravity = false;
-		rigidBody->SetVelocity(Vector3{ 0.0f, 0.0f, 0.0f });
 
 		// Planes don't use particles
+
+		// Damage the player if they fly into the plane (within 2 units along Z & 1 unit along Y).
+		// 6.0f is mesh renderer's offset for plane.
+		TriggerCollider* trigger = static_cast<TriggerCollider*>(GetEntity()->GetComponent(TriggerColliderC));
+		trigger->SetBox(Vector3(0.0f, 6.0f, 0.0f), Vector3(10.0f, 1.0f, 2.0f));
+		trigger->SetTriggerTag(PLAYER);
+		trigger->SetOnTriggerEnterCallback([this](Collider*) {
+			this->OnPlayerReached();
+		});
 	}
 	else if (breakableType == BreakableType::Pyramid)
 	{
@@ -158,24 +167,6 @@ void Breakable::Update(float deltaTime)
 		}
 		else if (breakableType == BreakableType::Plane)
 		{
-			// Check if it got very close to the camera
-			Vector3& cameraPos = RenderSystem::Get().GetCameraPosition();
-			Vector3& position = GetEntity()->GetTransform().position;
-			if ((std::abs(position.z - std::abs(cameraPos.z)) < 2.0f) && (std::abs(position.y + 6.0 - std::abs(cameraPos.y)) < 1.0f))
-			{
-				UIBuffer damage;
-				damage.position.x = APP_VIRTUAL_WIDTH / 2 - 70;
-				damage.position.y = APP_VIRTUAL_HEIGHT - 60;
-				damage.project = false;
-				damage.timeRemaining = 2.0f;
-				damage.text = "Took Damage! (-10)";
-				damage.color = Vector3(1.0f, 0.0f, 0.0f);
-				uiManager->ScheduleRender(damage);
-				uiManager->DecreaseBalls(10);
-
-				Break(false);
-			}
-
 			// Move if it should
 			if (moveVertically)
 			{
@@ -185,13 +176,33 @@ void Breakable::Update(float deltaTime)
 	}
 }
 
+void Breakable::OnPlayerReached()
+{
+	if (timeToDie)
+		return;
+
+	UIBuffer damage;
+	damage.position.x = APP_VIRTUAL_WIDTH / 2 - 70;
+	damage.position.y = APP_VIRTUAL_HEIGHT - 60;
+	damage.project = false;
+	damage.timeRemaining = 2.0f;
+	damage.text = "Took Damage! (-10)";
+	damage.color = Vector3(1.0f, 0.0f, 0.0f);
+	uiManager->ScheduleRender(damage);
+	uiManager->DecreaseBalls(10);
+
+	Break(false);
+}
+
 void Breakable::SHMMovement(float deltaTime)
 {
 	theta = std::fmod(theta + deltaTime / 1000.0f, 2 * PI);
 	float position = amplitude * std::sinf(theta);
 
 	// 6.0f is mesh renderer's offset for plane. Wish I had the time to fix this
-	GetEntity()->GetTransform().position.y = position - 6.0f;
+	Vector3 target = GetEntity()->GetTransform().position;
+	target.y = position - 6.0f;
+	rigidBody->MoveKinematic(target);
 }
 
 void Breakable::Break(float updateScore)
@@ -203,10 +214,7 @@ void Breakable::Break(float updateScore)
 	meshRenderer->SetHideMesh(true);
 
 	// Spawn broken pieces
-	for (Mesh& mesh : brokenPieces)
-	{
-		SpawnBrokenPieces(mesh);
-	}
+	SpawnBrokenPieces();
 
 	// Start particle effects
 	if (breakableType == Pyramid)
@@ -260,35 +268,21 @@ void Breakable::Break(float updateScore)
 	timeToDie = true;
 }
 
-void Breakable::SpawnBrokenPieces(Mesh& mesh)
+void Breakable::SpawnBrokenPieces()
 {
-	Scene* scene = SceneManager::Get().GetActiveScene();
-	Entity* entity = scene->CreateEntity(std::vector<ComponentType>{ MeshRendererC, RigidBodyC, SelfDestructC });
-	entity->SetName("BrokenPiece");
-
 	Transform& transform = GetEntity()->GetTransform();
-	Vector3 randomFactor{ 0.0f, Random::Get().Float() * 2.0f - 1.0f, 0.0f };
-	entity->GetTransform().position = transform.position + randomFactor;
-	entity->GetTransform().rotation = transform.rotation;
-	entity->GetTransform().scale = transform.scale;
-
-	// Load the mesh
-	MeshRenderer* mr = static_cast<MeshRenderer*>(entity->GetComponent(MeshRendererC));
-	mr->LoadMesh(mesh);
-	mr->SetRenderBackSide(false);
-	mr->SetMeshColor(meshRenderer->GetMeshColor());
-
-	// Apply outward velocity
-	RigidBody* rb = static_cast<RigidBody*>(entity->GetComponent(RigidBodyC));
-	Vector3 velocity{ (Random::Get().Float() * 2.0f - 1.0f) * 0.1f, Random::Get().Float() * 0.1f, Random::Get().Float() };
-	velocity.Normalize();
-	velocity *= 20.0f;
-	rb->SetVelocity(velocity);
-
-	// Self destuct data
-	SelfDestruct* sd = static_cast<SelfDestruct*>(entity->GetComponent(SelfDestructC));
-	sd->SetBound(Vector3(0.0f, -20.0f, 0.0f));  // Currently it checks only Y
-
-	// Initialize
-	entity->Initialize();
+
+	DebrisBurst burst;
+	burst.position = transform.position;
+	burst.rotation = transform.rotation;
+	burst.scale = transform.scale;
+	burst.color = meshRenderer->GetMeshColor();
+	// Pieces fly away from the player
+	burst.velocitySpread = Vector3(0.1f, 0.1f, 1.0f);
+	burst.speed = 20.0f;
+	burst.verticalJitter = 1.0f;
+
+	// Without the floor, the pieces would fall through the level till the kill height
+	DebrisSystem::Get().SetFloor(true, DEBRIS_FLOOR_HEIGHT);
+	DebrisSystem::Get().SpawnBurst(brokenPieces, burst);
 }
@@ -7,13 +7,13 @@
 #define _BREAKABLE_H_
 
 #include "Engine/Components/Component.h"
-#include "Engine/Math/Mesh.h"
 
 class MeshRenderer;
 class RigidBody;
 class Particles;
 class UIManager;
 class DoorOpener;
+class TriggerCollider;
 
 enum BreakableType
 {
@@ -41,8 +41,10 @@ class Breakable : public Component
 	// Doors to open
 	std::vector<DoorOpener*> doorOpeners;
 
-	// Broken mesh parts
-	std::list<Mesh> brokenPieces;
+	// Debris mesh IDs of the broken parts
+	std::vector<int> brokenPieces;
+	// Broken parts land on top of the wall rows (LevelGenerator puts them at y = -16, 16 units high)
+	const float DEBRIS_FLOOR_HEIGHT = -8.0f;
 
 	// Is the breakable moving vertically? Used for plane.
 	float amplitude = 10.0f;
@@ -54,9 +56,11 @@ class Breakable : public Component
 	float timeLeft = 1.0f;
 
 	void LoadMeshes(std::string& meshObjFile, size_t meshPieces);
-	void SpawnBrokenPieces(Mesh& mesh);
+	void SpawnBrokenPieces();
 	// Perform SHM movement along Y axis
 	void SHMMovement(float);
+	// Plane hits the player
+	void OnPlayerReached();
 
 public:
 	Breakable() { type = BreakableC; }
@@ -9,22 +9,39 @@
 #include "Engine/Components/Entity.h"
 #include "Engine/Components/Transform.h"
 #include "Engine/Components/MeshRenderer.h"
+#include "Engine/Components/TriggerCollider.h"
+#include "Engine/Components/RigidBody.h"
 #include "Engine/Systems/SceneManager.h"
 #include "Engine/Systems/Scene.h"
-#include "Engine/Systems/RenderSystem.h"
 #include "Game/UIManager.h"
 
 void DoorOpener::Initialize()
 {
 	// Find the UIManager
-	std::list<Entity*> match = SceneManager::Get().GetActiveScene()->FindEntityWithComponent(UIManagerC);
-	if (match.size() == 0)
+	Entity* uiManagerEntity = SceneManager::Get().GetActiveScene()->FindUniqueEntityWithComponent(UIManagerC);
+	if (uiManagerEntity == nullptr)
 		Logger::Get().Log("Door opener could not find UI Manager", ERROR_LOG);
 	else
-		uiManager = static_cast<UIManager*>(match.front()->GetComponent(UIManagerC));
+		uiManager = static_cast<UIManager*>(uiManagerEntity->GetComponent(UIManagerC));
 
 	tookDamage = false;
 	soundPlayed = false;
+
+	rigidBody = static_cast<RigidBody*>(GetEntity()->GetComponent(RigidBodyC));
+	rigidBody->SetKinematic(true);
+
+	// Instead of applying half damage from left & half damage from right gate,
+	// we'll apply total damage from left gate and ignore the right gate.
+	trigger = static_cast<TriggerCollider*>(GetEntity()->GetComponent(TriggerColliderC));
+	if (trigger != nullptr)
+	{
+		// Player moves through the middle of the level (along Z). Damage them if they get within 2 units of the door.
+		trigger->SetBox(Vector3(0.0f, 0.0f, 0.0f), Vector3(10.0f, 10.0f, 2.0f));
+		trigger->SetTriggerTag(PLAYER);
+		trigger->SetOnTriggerEnterCallback([this](Collider*) {
+			this->OnPlayerReached();
+		});
+	}
 }
 
 void DoorOpener::Update(float deltaTime)
@@ -36,35 +53,35 @@ void DoorOpener::Update(float deltaTime)
 	{
 		if (!soundPlayed)
 		{
-			App::PlaySound("Assets/Sounds/door_open.wav");
+			// Updated in parallel, the sound is played from the main thread
+			SceneManager::Get().GetActiveScene()->Defer([]() { App::PlaySound("Assets/Sounds/door_open.wav"); });
 			soundPlayed = true;
 		}
 		int sign = (openLeft) ? -1 : 1;
-		GetEntity()->GetTransform().Translate(Vector3(moveSpeed * sign * (deltaTime / 1000.0f), 0.0f, 0.0f));
-	}
-	// Instead of applying half damage from left & half damage from right gate,
-	// we'll apply total damage from left gate and ignore the right gate.
-	else if(openLeft && uiManager)
-	{
-		// Damage player if they get too close
-		Vector3& cameraPos = RenderSystem::Get().GetCameraPosition();
-		Vector3& position = GetEntity()->GetTransform().position;
-		if (std::abs(position.z - std::abs(cameraPos.z)) < 2.0f)
-		{
-			UIBuffer damage;
-			damage.position.x = APP_VIRTUAL_WIDTH / 2 - 70;
-			damage.position.y = APP_VIRTUAL_HEIGHT - 60;
-			damage.project = false;
-			damage.timeRemaining = 2.0f;
-			damage.text = "Took Damage! (-10)";
-			damage.color = Vector3(1.0f, 0.0f, 0.0f);
-			uiManager->ScheduleRender(damage);
-			uiManager->DecreaseBalls(10);
-			tookDamage = true;
-		}
+		Vector3 target = GetEntity()->GetTransform().position;
+		target.x += moveSpeed * sign * (deltaTime / 1000.0f);
+		rigidBody->MoveKinematic(target);
 	}
 }
 
+void DoorOpener::OnPlayerReached()
+{
+	// Open door doesn't hurt
+	if (tookDamage || openDoorNow || !uiManager)
+		return;
+
+	UIBuffer damage;
+	damage.position.x = APP_VIRTUAL_WIDTH / 2 - 70;
+	damage.position.y = APP_VIRTUAL_HEIGHT - 60;
+	damage.project = false;
+	damage.timeRemaining = 2.0f;
+	damage.text = "Took Damage! (-10)";
+	damage.color = Vector3(1.0f, 0.0f, 0.0f);
+	uiManager->ScheduleRender(damage);
+	uiManager->DecreaseBalls(10);
+	tookDamage = true;
+}
+
 void DoorOpener::SetOpenDoor(bool value)
 {
 	openDoorNow = value;
@@ -9,6 +9,8 @@
 #include "Engine/Components/Component.h"
 
 class UIManager;
+class TriggerCollider;
+class RigidBody;
 
 class DoorOpener : public Component
 {
@@ -25,8 +27,16 @@ class DoorOpener : public Component
 
 	float moveSpeed = 10.0f;
 
+	// Set off when the player reaches the door. Only the left door has it.
+	TriggerCollider* trigger = nullptr;
+	// Kinematic body moving the door, so that it pushes the balls in its way
+	RigidBody* rigidBody = nullptr;
+
+	void OnPlayerReached();
+
 public:
-	DoorOpener() { type = DoorOpenerC; }
+	// Only moves its own rigid body, the sound is deferred
+	DoorOpener() { type = DoorOpenerC; isParallelSafe = true; }
 
 	void SetOpenDoor(bool value);
 	void SetOpensLeft(bool value) { openLeft = value; }
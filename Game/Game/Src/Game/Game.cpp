@@ -17,6 +17,11 @@
 #include "Engine/Math/EngineMath.h"
 #include "Engine/Systems/RenderSystem.h"
 #include "Engine/Systems/PhysicsSystem.h"
+#include "Engine/Systems/CollisionSystem.h"
+#include "Engine/Systems/SceneManager.h"
+#include "Engine/Algorithms/BroadphaseRecording.h"
+#include "Engine/Algorithms/BroadphaseBenchmark.h"
+#include "Game/UIManager.h"
 
 // Unit tests
 #include "Engine/Math/Tests/TestVector3.h"
@@ -26,7 +31,17 @@
 #include "Engine/Math/Tests/TestMesh.h"
 #include "Engine/Algorithms/Tests/TestAABB.h"
 #include "Engine/Algorithms/Tests/TestBVH.h"
+#include "Engine/Algorithms/Tests/TestQuantizedBVH.h"
+#include "Engine/Algorithms/Tests/TestBroadphaseBenchmark.h"
 #include "Engine/Core/Tests/TestUtil.h"
+#include "Engine/Core/Tests/TestDenseRegistry.h"
+#include "Engine/Core/Tests/TestJobSystem.h"
+#include "Engine/Core/Tests/TestSystemScheduler.h"
+#include "Engine/Pools/Tests/TestArchetypeStorage.h"
+#include "Engine/Pools/Tests/TestComponentAllocator.h"
+#include "Engine/Pools/Tests/TestObjectPool.h"
+#include "Engine/Systems/Tests/TestScene.h"
+#include "Engine/Systems/Tests/TestDebrisSystem.h"
 
 extern void LoadGameScene();
 
@@ -48,16 +63,58 @@ void Init()
 	TestMesh::RunTests();
 	TestAABB::RunTests();
 	TestBVH::RunTests();
+	TestQuantizedBVH::RunTests();
+	TestBroadphaseBenchmark::RunTests();
 	TestGetHashCode();
+	TestHashBytes();
+	TestDenseRegistry::RunTests();
+	TestJobSystem::RunTests();
+	TestSystemScheduler::RunTests();
+	TestArchetypeStorage::RunTests();
+	TestComponentAllocator::RunTests();
+	TestObjectPool::RunTests();
+	TestScene::RunTests();
+	TestDebrisSystem::RunTests();
 #endif
 
 	// Systems settings
 	PhysicsSystem::Get().SetGravity(-9.8f);
 	RenderSystem::Get().SetDepthShadow(true);
+#ifdef DETERMINISTIC_RUN
+	// Fixed tick & seeded randomness. Logged state hashes of two runs can be diffed.
+	Engine::Get().SetDeterministic(true);
+	Engine::Get().SetLogStateHash(true);
+#endif
+#ifdef PROFILE_SYSTEMS
+	// Average & worst time of every engine system, logged every few seconds
+	Engine::Get().SetLogSystemTimings(true);
+#endif
+#ifdef RECORD_BROADPHASE
+	// Boxes of every frame get saved. Replay them with BENCHMARK_BROADPHASE.
+	CollisionSystem::Get().StartRecording("broadphase.rec");
+#endif
+#ifdef BENCHMARK_BROADPHASE
+	// Compare the broadphases on a recorded run
+	BroadphaseRecording recording;
+	if (recording.Load("broadphase.rec"))
+	{
+		BroadphaseBenchmark benchmark;
+		benchmark.Run(recording);
+		benchmark.LogSummary();
+		benchmark.SaveCSV("broadphase.csv");
+	}
+#endif
+
+	// Entity pools get created at these sizes when the scene loads
+	SceneManager::Get().LoadPoolConfig("Assets/ObjectPoolConfig.txt");
 
 	// Load the game scene
 	LoadGameScene();
 
+	// UI timers only touch the UI managers, so they don't need to wait for the engine systems
+	Engine::Get().AddGameSystem("UI Timers", [](float deltaTime) { UIManager::UpdateAllTimers(deltaTime); },
+		SystemResourceBit(ENTITY_DATA), SystemResourceBit(UI_DATA), false);
+
 	Engine::Get().Initialize();
 }
 
@@ -85,5 +142,10 @@ void Render()
 //------------------------------------------------------------------------
 void Shutdown()
 {
+#ifdef PROFILE_POOLS
+	// Pool sizes this session needed. Copy over Assets/ObjectPoolConfig.txt to stop pools growing in game.
+	SceneManager::Get().LogPoolUsage();
+	SceneManager::Get().SavePoolConfig("ObjectPoolConfig.suggested.txt");
+#endif
 	Engine::Get().Destroy();
 }
@@ -15,7 +15,7 @@ void LoadGameEntities(Scene* scene)
 	entity->SetName("LevelGenerator");
 
 	// ---------------------- Ball Spawner ----------------------
-	entity = scene->CreateEntity(std::vector<ComponentType>{ BallSpawnerC, ParticlesC });
+	entity = scene->CreateEntity(std::vector<ComponentType>{ BallSpawnerC, ParticlesC, TriggerColliderC });
 	entity->SetName("BallSpawner");
 
 	// Set ball spawner data
@@ -15,6 +15,8 @@
 #include "Engine/Components/MeshRenderer.h"
 #include "Engine/Components/RigidBody.h"
 #include "Engine/Components/Particles.h"
+#include "Engine/Components/BoxCollider.h"
+#include "Engine/Systems/CollisionSystem.h"
 #include "Engine/Math/Vector3.h"
 #include "Engine/Math/Random.h"
 #include "Game/SelfDestruct.h"
@@ -31,23 +33,22 @@ void LevelGenerator::Initialize()
 	_countIter = 0;
 
 	// Find the player entity and cache it
-	std::list<Entity*> matchedEntities = SceneManager::Get().GetActiveScene()->FindEntityWithComponent(BallSpawnerC);
-	if (matchedEntities.size() == 0)
+	ballSpawnerEntity = SceneManager::Get().GetActiveScene()->FindUniqueEntityWithComponent(BallSpawnerC);
+	if (ballSpawnerEntity == nullptr)
 	{
 		Logger::Get().Log("Level generator could not find ball spawner", ERROR_LOG);
 	}
 	else
 	{
-		ballSpawnerEntity = matchedEntities.front();
 		ballSpawner = static_cast<BallSpawner*>(ballSpawnerEntity->GetComponent(BallSpawnerC));
 	}
 
 	// Find the UIManager
-	std::list<Entity*> match = SceneManager::Get().GetActiveScene()->FindEntityWithComponent(UIManagerC);
-	if (match.size() == 0)
+	Entity* uiManagerEntity = SceneManager::Get().GetActiveScene()->FindUniqueEntityWithComponent(UIManagerC);
+	if (uiManagerEntity == nullptr)
 		Logger::Get().Log("Level generator could not find UI Manager", ERROR_LOG);
 	else
-		uiManager = static_cast<UIManager*>(match.front()->GetComponent(UIManagerC));
+		uiManager = static_cast<UIManager*>(uiManagerEntity->GetComponent(UIManagerC));
 }
 
 void LevelGenerator::Update(float deltaTime)
@@ -60,15 +61,68 @@ void LevelGenerator::Update(float deltaTime)
 		lastSpawnDistance += SEPARATION_DIST;
 		SpawnLevel(lastSpawnDistance);
 	}
+
+	DespawnPassedEntities(playerPosition);
 }
 
-Entity* LevelGenerator::CreateWallEntity(Vector3& position, Vector3& scale, bool isDoor, bool opensLeft)
+void LevelGenerator::DespawnPassedEntities(float playerPosition)
+{
+	passedColliders.clear();
+	CollisionSystem::Get().QueryZRangeOverlaps(-std::numeric_limits<float>::max(), playerPosition, passedColliders);
+
+	Scene* scene = SceneManager::Get().GetActiveScene();
+	for (BoxCollider* boxC : passedColliders)
+	{
+		Entity* entity = boxC->GetEntity();
+		SelfDestruct* sd = static_cast<SelfDestruct*>(entity->GetComponent(SelfDestructC));
+		// Each entity stays till the player is far enough ahead of it
+		if (sd != nullptr && playerPosition > entity->GetTransform().position.z + sd->GetBound().z)
+			scene->RemoveEntity(entity);
+	}
+}
+
+std::vector<ComponentType> LevelGenerator::WallComponents(bool isDoor, bool opensLeft)
 {
 	std::vector<ComponentType> comps{ MeshRendererC, BoxColliderC, SelfDestructC };
+	// Doors are moved by script & push the balls in their way
 	if (isDoor)
+	{
 		comps.push_back(DoorOpenerC);
+		comps.push_back(RigidBodyC);
+	}
+	// Left door damages the player passing through it
+	if (isDoor && opensLeft)
+		comps.push_back(TriggerColliderC);
+	return comps;
+}
+
+std::vector<ComponentType> LevelGenerator::BreakableComponents(BreakableType breakableType)
+{
+	std::vector<ComponentType> comps{ MeshRendererC, BoxColliderC, RigidBodyC, ParticlesC, BreakableC, SelfDestructC };
+	// Plane damages the player flying into it
+	if (breakableType == BreakableType::Plane)
+		comps.push_back(TriggerColliderC);
+	return comps;
+}
 
+Entity* LevelGenerator::CreateWallEntity(Vector3& position, Vector3& scale, bool isDoor, bool opensLeft)
+{
+	std::vector<ComponentType> comps = WallComponents(isDoor, opensLeft);
 	Entity* entity = SceneManager::Get().GetActiveScene()->CreateEntity(comps);
+	SetupWallEntity(entity, position, scale, isDoor, opensLeft);
+	return entity;
+}
+
+Entity* LevelGenerator::CreateBreakableEntity(Vector3& position, Vector3& scale, Vector3& rotation, BreakableType breakableType)
+{
+	std::vector<ComponentType> comps = BreakableComponents(breakableType);
+	Entity* entity = SceneManager::Get().GetActiveScene()->CreateEntity(comps);
+	SetupBreakableEntity(entity, position, scale, rotation, breakableType);
+	return entity;
+}
+
+void LevelGenerator::SetupWallEntity(Entity* entity, Vector3& position, Vector3& scale, bool isDoor, bool opensLeft)
+{
 	entity->SetName("Wall");
 
 	// Load the transform data
@@ -94,13 +148,10 @@ Entity* LevelGenerator::CreateWallEntity(Vector3& position, Vector3& scale, bool
 
 	// Initialize
 	entity->Initialize();
-
-	return entity;
 }
 
-Entity* LevelGenerator::CreateBreakableEntity(Vector3& position, Vector3& scale, Vector3& rotation, BreakableType breakableType)
+void LevelGenerator::SetupBreakableEntity(Entity* entity, Vector3& position, Vector3& scale, Vector3& rotation, BreakableType breakableType)
 {
-	Entity* entity = SceneManager::Get().GetActiveScene()->CreateEntity(std::vector<ComponentType>{ MeshRendererC, BoxColliderC, RigidBodyC, ParticlesC, BreakableC, SelfDestructC });
 	entity->SetName("Breakable");
 	entity->GetTransform().position = position;
 	entity->GetTransform().scale = scale;
@@ -121,8 +172,6 @@ Entity* LevelGenerator::CreateBreakableEntity(Vector3& position, Vector3& scale,
 
 	// Initialize
 	entity->Initialize();
-
-	return entity;
 }
 
 void LevelGenerator::SpawnLevel(float zPos)
@@ -173,15 +222,23 @@ void LevelGenerator::SpawnLevel(float zPos)
 		Vector3 breakableScale{ 2.0f, 2.0f, 2.0f };
 		Vector3 breakableRotation{ 0.0f, 0.0f, 0.0f };
 
-		CreateWallEntity(Vector3(-15.0f, -16.0f, zPos), wallScale);
-		CreateWallEntity(Vector3(15.0f, -16.0f, zPos), wallScale);
-		CreateBreakableEntity(Vector3(-15.0f, -3.0f, zPos), breakableScale, breakableRotation, BreakableType::Pyramid);
-		CreateBreakableEntity(Vector3(15.0f, -3.0f, zPos), breakableScale, breakableRotation, BreakableType::Pyramid);
-		
-		if (Random::Get().Float() > 0.2f)
+		// Left & right always, middle most of the time
+		const float rowX[3] = { -15.0f, 15.0f, 0.0f };
+		size_t rowCount = (Random::Get().Float() > 0.2f) ? 3 : 2;
+
+		// Whole row comes from the pools in one go
+		Scene* scene = SceneManager::Get().GetActiveScene();
+		std::vector<ComponentType> wallComps = WallComponents(false, false);
+		std::vector<ComponentType> breakableComps = BreakableComponents(BreakableType::Pyramid);
+		rowWalls.clear();
+		rowBreakables.clear();
+		scene->CreateEntities(wallComps, rowCount, rowWalls);
+		scene->CreateEntities(breakableComps, rowCount, rowBreakables);
+
+		for (size_t i = 0; i < rowCount; i++)
 		{
-			CreateWallEntity(Vector3(0.0f, -16.0f, zPos), wallScale);
-			CreateBreakableEntity(Vector3(0.0f, -3.0f, zPos), breakableScale, breakableRotation, BreakableType::Pyramid);
+			SetupWallEntity(rowWalls[i], Vector3(rowX[i], -16.0f, zPos), wallScale, false, false);
+			SetupBreakableEntity(rowBreakables[i], Vector3(rowX[i], -3.0f, zPos), breakableScale, breakableRotation, BreakableType::Pyramid);
 		}
 	}
 
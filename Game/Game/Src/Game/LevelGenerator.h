@@ -12,6 +12,7 @@
 class Entity;
 class BallSpawner;
 class UIManager;
+class BoxCollider;
 enum BreakableType;
 
 class LevelGenerator : public Component
@@ -33,10 +34,26 @@ class LevelGenerator : public Component
 	int _countIter = 0;
 	bool isFirstDoor = true;
 
+	// Reused by DespawnPassedEntities every frame
+	std::vector<BoxCollider*> passedColliders;
+	// Reused by SpawnLevel for the entities of a row
+	std::vector<Entity*> rowWalls;
+	std::vector<Entity*> rowBreakables;
+
+	static std::vector<ComponentType> WallComponents(bool isDoor, bool opensLeft);
+	static std::vector<ComponentType> BreakableComponents(BreakableType breakableType);
+	void SetupWallEntity(Entity* entity, Vector3& position, Vector3& scale, bool isDoor, bool opensLeft);
+	void SetupBreakableEntity(Entity* entity, Vector3& position, Vector3& scale, Vector3& rotation, BreakableType breakableType);
+
 	Entity* CreateWallEntity(Vector3& position, Vector3& scale, bool isDoor = false, bool opensLeft = false);
 	Entity* CreateBreakableEntity(Vector3& position, Vector3& scale, Vector3& rotation, BreakableType breakableType);
 	
 	void SpawnLevel(float zPos);
+	/**
+	 * @brief Remove the self destructing entities the player went past.
+	 * Everything behind the player is found with a single collision query.
+	 */
+	void DespawnPassedEntities(float playerPosition);
 
 public:
 	LevelGenerator() { type = LevelGeneratorC; }
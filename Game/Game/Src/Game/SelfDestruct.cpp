@@ -8,17 +8,6 @@
 #include "Engine/Components/Transform.h"
 #include "Engine/Systems/SceneManager.h"
 #include "Engine/Systems/Scene.h"
-#include "Engine/Core/Logger.h"
-
-void SelfDestruct::Initialize()
-{
-	// Find the player entity and cache it
-	std::list<Entity*> matchedEntities = SceneManager::Get().GetActiveScene()->FindEntityWithComponent(BallSpawnerC);
-	if (matchedEntities.size() == 0)
-		Logger::Get().Log("Could not find ball spawner");
-	else
-		playerEntity = matchedEntities.front();
-}
 
 void SelfDestruct::Update(float deltaTime)
 {
@@ -26,13 +15,8 @@ void SelfDestruct::Update(float deltaTime)
 
 	if (position.y <= bound.y)
 	{
-		// Remove this entity from the scene
-		SceneManager::Get().GetActiveScene()->RemoveEntity(GetEntity());
-	}
-	else if (playerEntity != nullptr)
-	{
-		// If the object goes beyond the player, self destruct
-		if (playerEntity->GetTransform().position.z > position.z + bound.z)
-			SceneManager::Get().GetActiveScene()->RemoveEntity(GetEntity());
+		// Remove this entity from the scene. Updated in parallel, so the removal waits for the main thread.
+		SceneManager::Get().GetActiveScene()->DeferRemoveEntity(GetEntity());
 	}
+	// Objects the player went past are removed by the level generator, all of them with a single query
 }
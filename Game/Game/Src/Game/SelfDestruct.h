@@ -9,21 +9,20 @@
 #include "Engine/Components/Component.h"
 #include "Engine/Math/Vector3.h"
 
-class Entity;
-
 class SelfDestruct : public Component
 {
-	// Self destructs if it goes below this position
+	// Self destructs if it goes below bound.y.
+	// Also removed by the level generator once the player is bound.z ahead of it.
 	Vector3 bound{ 0.0f, -20.0f, 10.0f };
 
-	Entity* playerEntity = nullptr;
-
 public:
-	SelfDestruct() { type = SelfDestructC; }
+	// Only reads its own transform, removal is deferred
+	SelfDestruct() { type = SelfDestructC; isParallelSafe = true; }
 
 	void SetBound(Vector3& b) { bound = b; }
+	const Vector3& GetBound() const { return bound; }
 
-	void Initialize() override;
+	void Initialize() override {}
 	void Update(float) override;
 	void Destroy() override {}
 };
@@ -58,38 +58,9 @@ void UIManager::Update(float deltaTime)
 		return;
 	}
 
+	// Timers are updated by the "UI Timers" system (see UpdateAllTimers)
 	if (!gamePaused)
 	{
-		// To prevent rendering other messages if tutorial is running
-		if (isTutorialUp)
-		{
-			tutorial_timer -= (deltaTime / 1000.0f);
-			if (tutorial_timer <= 0)
-			{
-				tutorial_timer = 0.0f;
-				isTutorialUp = false;
-			}
-		}
-		// Check if any items from render buffer should be removed
-		for (UIBuffer& uiBuffer : renderBuffer)
-		{
-			uiBuffer.timeRemaining -= (deltaTime / 1000.0f);
-		}
-		renderBuffer.remove_if([](const UIBuffer& uiB) { return (uiB.timeRemaining <= 0); });
-
-		if (obstacles_msg_timer > 0.0f)
-		{
-			obstacles_msg_timer -= (deltaTime / 1000.0f);
-			if (obstacles_msg_timer <= 0)
-				DisplayObstaclesMsg();
-		}
-		if (stars_msg_timer > 0.0f)
-		{
-			stars_msg_timer -= (deltaTime / 1000.0f);
-			if (stars_msg_timer <= 0)
-				DisplayStarsMsg();
-		}
-
 		// Song change
 		if (songPlaying == 0)
 		{
@@ -117,6 +88,54 @@ void UIManager::Update(float deltaTime)
 		CheckForGamePause();
 }
 
+void UIManager::UpdateTimers(float deltaTime)
+{
+	if (!gameStarted || gamePaused)
+		return;
+
+	// To prevent rendering other messages if tutorial is running
+	if (isTutorialUp)
+	{
+		tutorial_timer -= (deltaTime / 1000.0f);
+		if (tutorial_timer <= 0)
+		{
+			tutorial_timer = 0.0f;
+			isTutorialUp = false;
+		}
+	}
+	// Check if any items from render buffer should be removed
+	for (UIBuffer& uiBuffer : renderBuffer)
+	{
+		uiBuffer.timeRemaining -= (deltaTime / 1000.0f);
+	}
+	renderBuffer.remove_if([](const UIBuffer& uiB) { return (uiB.timeRemaining <= 0); });
+
+	if (obstacles_msg_timer > 0.0f)
+	{
+		obstacles_msg_timer -= (deltaTime / 1000.0f);
+		if (obstacles_msg_timer <= 0)
+			DisplayObstaclesMsg();
+	}
+	if (stars_msg_timer > 0.0f)
+	{
+		stars_msg_timer -= (deltaTime / 1000.0f);
+		if (stars_msg_timer <= 0)
+			DisplayStarsMsg();
+	}
+}
+
+void UIManager::UpdateAllTimers(float deltaTime)
+{
+	Scene* scene = SceneManager::Get().GetActiveScene();
+	if (scene == nullptr)
+		return;
+
+	for (Entity* entity : scene->FindEntityWithComponent(UIManagerC))
+	{
+		static_cast<UIManager*>(entity->GetComponent(UIManagerC))->UpdateTimers(deltaTime);
+	}
+}
+
 void UIManager::Render()
 {
 	App::Print(20, 20, "ThatDNS.dev", 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_12);
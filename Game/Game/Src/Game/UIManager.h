@@ -50,6 +50,11 @@ class UIManager : public Renderable
 	// Anything added to it gets rendered for the specified time
 	std::list<UIBuffer> renderBuffer;
 
+	/**
+	 * @brief Count down the messages & tutorial timers. Touches nothing but this UI manager (no App calls).
+	 */
+	void UpdateTimers(float deltaTime);
+
 	void CheckForGameStart();
 	void CheckForGamePause();
 	void CheckForGameRestart();
@@ -66,6 +71,12 @@ public:
 	void Render() override;
 	void Destroy() override;
 
+	/**
+	 * @brief Update the timers of all the UI managers of the active scene.
+	 * Added to the engine as the "UI Timers" system, which runs on any thread alongside the engine systems.
+	 */
+	static void UpdateAllTimers(float deltaTime);
+
 	void ScheduleRender(UIBuffer& uiB);
 	void SetTutorialTimer(float timer);
 